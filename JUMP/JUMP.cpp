@@ -14,11 +14,15 @@
 #include "components/level-meter/jump_LevelMeterEngine.cpp"
 #include "components/level-meter/jump_MultiMeter.cpp"
 #include "components/spectrum-analyser/jump_SpectrumAnalyserEngine.cpp"
+#include "components/spectrum-analyser/jump_MultichannelSpectrumAnalyserEngine.cpp"
 #include "components/spectrum-analyser/jump_SpectrumAnalyser.cpp"
 #include "components/spectrum-analyser/jump_MultiAnalyser.cpp"
+#include "components/spectrogram/jump_SpectrogramEngine.cpp"
+#include "components/spectrogram/jump_Spectrogram.cpp"
 #include "components/windows/jump_ModalWindow.cpp"
 
 // Containers
+#include "containers/jump_MirroredMemoryBlock.cpp"
 
 // Interfaces
 #ifdef JucePlugin_Name
@@ -30,5 +34,15 @@
 #include "graphics/jump_LookAndFeel.cpp"
 
 // Utilities
+#include "utilities/jump_EngineScheduler.cpp"
+#include "utilities/jump_SharedFFTCache.cpp"
+
+// Tests
+#include "audio/jump_AudioTransferManager_test.cpp"
+#include "audio/jump_MultichannelAudioTransferManager_test.cpp"
+#include "components/spectrum-analyser/jump_SpectrumAnalyserEngine_test.cpp"
+#include "components/spectrum-analyser/jump_MultichannelSpectrumAnalyserEngine_test.cpp"
+#include "containers/jump_CircularBuffer_test.cpp"
+#include "interfaces/jump_StatefulObject_test.cpp"
 
 // clang-format on
@@ -47,14 +47,22 @@ namespace jump
 
     //==================================================================================================================
     static constexpr auto defaultMinusInfDB = -100.0;
+
+    /** The size, in bytes, used to keep data written by different threads on separate cache lines. */
+    static constexpr std::size_t cacheLineSize = 64;
 } // namespace jump
 
 //======================================================================================================================
 // clang-format off
 
 // Audio
+    #include "audio/jump_DoubleBufferIndex.h"
 #include "audio/jump_AudioTransferManager.h"
+#include "audio/jump_AudioTransferRingBuffer.h"
+#include "audio/jump_MultichannelAudioTransferManager.h"
+#include "audio/jump_LatestValueTransfer.h"
 #include "audio/jump_Level.h"
+#include "audio/jump_LevelSummary.h"
 #include "audio/jump_Compressor.h"
 
 // Components
@@ -66,19 +74,29 @@ namespace jump
 #include "components/buttons/jump_BrandLogoButton.h"
     #include "interfaces/jump_StatefulObject.h"
     #include "containers/jump_CircularBuffer.h"
+        #include "containers/jump_MirroredMemoryBlock.h"
+    #include "containers/jump_MirroredCircularBuffer.h"
+        #include "utilities/jump_EngineScheduler.h"
     #include "interfaces/jump_AudioComponentEngine.h"
+    #include "utilities/jump_SharedAnalysisThread.h"
+    #include "containers/jump_TripleBuffer.h"
 #include "components/level-meter/jump_LevelMeterEngine.h"
     #include "graphics/jump_Container.h"
 #include "components/level-meter/jump_LevelMeter.h"
     #include "utilities/jump_Functions.h"
 #include "components/level-meter/jump_LevelMeterLabelsComponent.h"
 #include "components/level-meter/jump_MultiMeter.h"
+    #include "utilities/jump_DecibelVectorOperations.h"
+    #include "utilities/jump_SharedFFTCache.h"
 #include "components/spectrum-analyser/jump_SpectrumAnalyserEngine.h"
+#include "components/spectrum-analyser/jump_MultichannelSpectrumAnalyserEngine.h"
     #include "graphics/jump_PaintOptions.h"
 #include "components/spectrum-analyser/jump_SpectrumAnalyser.h"
     #include "utilities/jump_VariantConverters.h"
 #include "components/spectrum-analyser/jump_SpectrumAnalyserLabelsComponent.h"
 #include "components/spectrum-analyser/jump_MultiAnalyser.h"
+#include "components/spectrogram/jump_SpectrogramEngine.h"
+#include "components/spectrogram/jump_Spectrogram.h"
 #include "components/utilities/jump_ComponentLayout.h"
 #include "components/windows/jump_ModalWindow.h"
 
@@ -7,22 +7,36 @@ namespace jump
     /** Manages the transfer of a stream of audio samples from a real-time thread to a non real-time thread (e.g.
         getting samples from an audio thread to a GUI thread).
 
-        This container only stores a single stream of samples so for multichannel applications a separate ATM is
-        required for each channel.
+        This container only stores a single stream of samples. For multichannel applications use a
+        MultichannelAudioTransferManager instead so all channels are published together and stay time-aligned.
 
         This class aims be thread safe via to the use of double buffering.
 
-        @tparam SampleType  The data type of samples to use (usually float or double).
-        @tparam capacity    The maximum number of samples allowed in each of the two internal buffers (so the total
-                            number of samples held by this container could be anything up to capacity * 2).
-                            You'll want to make sure the capacity is large enough to store every new sample that comes
-                            in between calls to read(). An easy way of calculating this is to divide the maximum
-                            expected sample rate by the rate at which you're reading. For example for a sample rate of
-                            192kHz and reading with a timer set to 60Hz, the capacity will need to be at least 3200. If
-                            you don't do this, you'll start losing more samples the higher your sample rate and the
-                            lower your reading rate which may affect the accuracy of your audio visualisers.
+        Both internal buffers live in a single heap allocation that's only ever (re)made by prepare() or setCapacity(),
+        so the container itself is small and nothing is allocated once the audio thread is running. Calling prepare()
+        from your processor's prepareToPlay() sizes the buffers for the actual sample rate rather than the worst case.
+
+        @code
+        void prepareToPlay(double sampleRate, int samplesPerBlock) override
+        {
+            transferManager.prepare(sampleRate, 60.0, samplesPerBlock);
+        }
+        @endcode
+
+        @tparam SampleType      The data type of samples to use (usually float or double).
+        @tparam initialCapacity The initial maximum number of samples allowed in each of the two internal buffers (so
+                                the total number of samples held by this container could be anything up to capacity *
+                                2). If this is zero, no memory is allocated until prepare() or setCapacity() is called.
+                                You'll want to make sure the capacity is large enough to store every new sample that
+                                comes in between calls to read(). Dividing the sample rate by the rate at which you're
+                                reading gives the number of samples in one read interval, but timers jitter and audio
+                                arrives in whole blocks, so prepare() allows for two intervals plus one block. For
+                                example for a sample rate of 48kHz, reading with a timer set to 60Hz and blocks of 512
+                                samples, the capacity will need to be at least 2112. If you don't do this, you'll start
+                                losing more samples the higher your sample rate and the lower your reading rate which
+                                may affect the accuracy of your audio visualisers.
     */
-    template <typename SampleType, int capacity>
+    template <typename SampleType, int initialCapacity = 0>
     class AudioTransferManager
     {
     public:
@@ -33,25 +47,106 @@ namespace jump
         */
         AudioTransferManager()
         {
+            setCapacity(initialCapacity);
         }
 
         /** Copy constructor.
 
-            Copies state and values from other.
+            Copies state and values from other. This allocates, and isn't thread safe so should only be used while
+            neither object is being written to or read from.
 
             @param other    The other ATM object to copy from.
         */
         AudioTransferManager(const AudioTransferManager& other)
-            : buffers{ other.buffers }
-            , idx{ other.idx.load() }
+            : idx{ other.idx }
         {
+            setCapacity(other.currentCapacity);
+
+            for (std::size_t i = 0; currentCapacity > 0 && i < buffers.size(); i++)
+            {
+                buffers[i].writeIndex = other.buffers[i].writeIndex;
+                std::memcpy(buffers[i].data,
+                            other.buffers[i].data,
+                            static_cast<std::size_t>(currentCapacity) * sizeof(SampleType));
+            }
         }
 
         ~AudioTransferManager()
         {
             static_assert(std::is_trivially_copyable<SampleType>::value,
                           "'SampleType' for AudioTransferManager must be trivially copyable.");
-            static_assert(capacity >= 0, "AudioTransferManager's capacity must be positive!");
+            static_assert(initialCapacity >= 0, "AudioTransferManager's capacity must be positive!");
+        }
+
+        //==============================================================================================================
+        /** Sizes the container so it can hold every sample written between two reads.
+
+            This allocates, and isn't thread safe, so should only be called while neither the writer nor the reader is
+            using the container - usually from prepareToPlay(). Any unread samples are discarded.
+
+            @param sampleRate   The rate at which samples will be written.
+            @param readRateHz   The rate at which the container will be read from, e.g. the frequency of a GUI timer.
+            @param maxBlockSize The largest number of samples that will be written in one go, e.g. the block size
+                                passed to prepareToPlay().
+
+            @see getRequiredCapacity()
+        */
+        void prepare(double sampleRate, double readRateHz, int maxBlockSize)
+        {
+            setCapacity(getRequiredCapacity(sampleRate, readRateHz, maxBlockSize));
+        }
+
+        /** Returns the capacity needed to hold every sample written between two reads.
+
+            A read may be late by up to a whole interval when the reading thread is busy, and the writer publishes whole
+            blocks, so this allows for two read intervals' worth of samples plus one block.
+
+            @param sampleRate   The rate at which samples will be written.
+            @param readRateHz   The rate at which the container will be read from.
+            @param maxBlockSize The largest number of samples that will be written in one go.
+        */
+        static int getRequiredCapacity(double sampleRate, double readRateHz, int maxBlockSize)
+        {
+            jassert(sampleRate > 0.0 && readRateHz > 0.0 && maxBlockSize >= 0);
+
+            return 2 * static_cast<int>(std::ceil(sampleRate / readRateHz)) + juce::jmax(maxBlockSize, 0);
+        }
+
+        /** Changes the maximum number of samples allowed in each of the two internal buffers.
+
+            Like prepare(), this allocates and isn't thread safe, and any unread samples are discarded.
+
+            @param newCapacity  The new capacity. If this is zero the container's memory is freed.
+        */
+        void setCapacity(int newCapacity)
+        {
+            jassert(newCapacity >= 0);
+
+            currentCapacity = juce::jmax(newCapacity, 0);
+
+            // Each buffer starts on its own cache line so the writer and reader never share one.
+            const auto bufferStride = roundUpToCacheLine(static_cast<std::size_t>(currentCapacity)
+                                                         * sizeof(SampleType));
+            char* alignedStorage = nullptr;
+
+            if (currentCapacity > 0)
+            {
+                storage.allocate(bufferStride * buffers.size() + cacheLineSize, true);
+                alignedStorage = juce::snapPointerToAlignment(storage.get(), cacheLineSize);
+            }
+            else
+            {
+                storage.free();
+            }
+
+            for (std::size_t i = 0; i < buffers.size(); i++)
+            {
+                buffers[i].data = alignedStorage != nullptr
+                                    ? reinterpret_cast<SampleType*>(alignedStorage + i * bufferStride)
+                                    : nullptr;
+                buffers[i].capacity = currentCapacity;
+                buffers[i].writeIndex = 0;
+            }
         }
 
         //==============================================================================================================
@@ -65,64 +160,130 @@ namespace jump
         */
         void write(SampleType sample)
         {
-            const auto writeIndex = idx.fetch_or(DataFlags::Busy) & DataFlags::IDX;
-            buffers[static_cast<std::size_t>(writeIndex)].write(sample);
-            idx.store((writeIndex & DataFlags::IDX) | DataFlags::NewData);
+            // The container needs to be given a capacity before it can be written to!
+            jassert(currentCapacity > 0);
+
+            if (currentCapacity <= 0)
+                return;
+
+            const auto writeIndex = idx.beginWrite();
+            buffers[writeIndex].write(sample);
+            idx.endWrite(writeIndex);
         }
 
+        /** Writes a block of samples to the container.
+
+            This behaves exactly as if write() had been called for each sample in turn, but the samples are copied in
+            at most two contiguous segments and the whole block is published with a single handshake with the reader.
+
+            @param samples      A pointer to the first sample to write.
+            @param numSamples   The number of samples to write.
+        */
         void write(const SampleType* samples, int numSamples)
         {
-            for (auto ptr = samples; ptr < samples + numSamples; ptr++)
-                write(*ptr);
+            // The container needs to be given a capacity before it can be written to!
+            jassert(currentCapacity > 0);
+
+            if (numSamples <= 0 || currentCapacity <= 0)
+                return;
+
+            const auto writeIndex = idx.beginWrite();
+            buffers[writeIndex].write(samples, numSamples);
+            idx.endWrite(writeIndex);
         }
 
         /** Returns a vector containing all new samples added to this container since it was last read from (or, if it
             hasn't been read from yet, since it was created).
 
-            Note that the size of the vector will vary and is not guaranteed to be equal to the capacity.
+            Note that the size of the vector will vary and is not guaranteed to be equal to the capacity. As this
+            allocates a new vector on every call, prefer one of the other read() overloads for regular reads.
 
             @returns    A vector containing the latest samples.
         */
         std::vector<SampleType> read() const
         {
-            // Get the current state of the idx.
-            auto currentIDX = idx.load();
+            std::vector<SampleType> result;
 
-            // Check if new data has been added since the last read.
-            if ((currentIDX & DataFlags::NewData) != 0)
-            {
-                auto newValue = -1;
+            read([&result](const SampleType* samples, int numSamples) {
+                result.insert(result.end(), samples, samples + numSamples);
+            });
 
-                // CAS loop.
-                // Keep looping until the idx is no longer busy.
-                do
-                {
-                    currentIDX &= ~DataFlags::Busy;
-                    newValue = (currentIDX ^ DataFlags::IDX) & DataFlags::IDX;
-                }
-                while (!idx.compare_exchange_weak(currentIDX, newValue));
+            return result;
+        }
 
-                // Something went wrong here - the value never got changed!
-                jassert(newValue != -1);
+        /** Passes all new samples added to this container since it was last read from to the given visitor, without
+            copying or allocating.
 
-                currentIDX = newValue;
-            }
+            The visitor is called with a pointer to the samples and the number of samples, oldest first. It's called
+            with up to two contiguous segments (although this container only ever produces one) and isn't called at all
+            if there are no new samples. The pointer is only valid for the duration of the call.
 
-            const auto readIndex = (currentIDX & DataFlags::IDX) ^ 1;
-            return buffers[static_cast<std::size_t>(readIndex)].read();
+            @param visitor  A callable with the signature void(const SampleType*, int).
+
+            @returns    The total number of samples passed to the visitor.
+        */
+        template <typename Visitor>
+        int read(Visitor&& visitor) const
+        {
+            auto& buffer = buffers[idx.acquireReadIndex()];
+            const auto numSamples = buffer.writeIndex;
+
+            if (numSamples > 0)
+                visitor(buffer.data, numSamples);
+
+            buffer.writeIndex = 0;
+
+            return numSamples;
+        }
+
+        /** Copies all new samples added to this container since it was last read from into the given destination,
+            without allocating.
+
+            If there are more new samples than will fit in the destination, only the most recent ones are copied.
+
+            @param destination      The array to copy the samples to, oldest first.
+            @param maxNumSamples    The number of samples the destination has space for.
+
+            @returns    The number of samples copied to the destination.
+        */
+        int read(SampleType* destination, int maxNumSamples) const
+        {
+            auto numCopied = 0;
+
+            read([&](const SampleType* samples, int numSamples) {
+                numCopied = juce::jmin(numSamples, maxNumSamples);
+                std::memcpy(destination,
+                            samples + (numSamples - numCopied),
+                            static_cast<std::size_t>(numCopied) * sizeof(SampleType));
+            });
+
+            return numCopied;
+        }
+
+        /** Copies all new samples added to this container since it was last read from into a channel of the given
+            buffer, without allocating.
+
+            If there are more new samples than will fit in the buffer, only the most recent ones are copied.
+
+            @param destination  The buffer to copy the samples to, oldest first.
+            @param channel      The channel of the buffer to copy the samples to.
+
+            @returns    The number of samples copied to the buffer.
+        */
+        int read(juce::AudioBuffer<SampleType>& destination, int channel) const
+        {
+            return read(destination.getWritePointer(channel), destination.getNumSamples());
         }
 
         /** Returns the capacity of this container. */
-        constexpr int getCapacity() const noexcept
+        int getCapacity() const noexcept
         {
-            return capacity;
+            return currentCapacity;
         }
 
     private:
         //==============================================================================================================
-        /** Implements the logic for reading and writing from the buffers using a fixed-size array and an incrementing
-            write index.
-        */
+        /** Implements the logic for reading and writing from one of the buffers using an incrementing write index. */
         struct BufferWrapper
         {
             void write(SampleType sample)
@@ -130,33 +291,39 @@ namespace jump
                 if (writeIndex >= capacity)
                     writeIndex = 0;
 
-                buffer[static_cast<std::size_t>(writeIndex++)] = sample;
+                data[writeIndex++] = sample;
             }
 
-            std::vector<SampleType> read() const
+            void write(const SampleType* samples, int numSamples)
             {
-                std::vector<SampleType> result(static_cast<std::size_t>(writeIndex));
-                std::copy(buffer.cbegin(), buffer.cbegin() + writeIndex, result.begin());
+                // Only the most recent samples can survive the wrap so there's no point copying any others.
+                const auto numToCopy = juce::jmin(numSamples, capacity);
+                const auto start = (writeIndex + numSamples - numToCopy) % capacity;
+                const auto numBeforeWrap = juce::jmin(numToCopy, capacity - start);
+                samples += numSamples - numToCopy;
 
-                writeIndex = 0;
+                std::memcpy(data + start, samples, static_cast<std::size_t>(numBeforeWrap) * sizeof(SampleType));
+                std::memcpy(data, samples + numBeforeWrap,
+                            static_cast<std::size_t>(numToCopy - numBeforeWrap) * sizeof(SampleType));
 
-                return result;
+                writeIndex = (writeIndex + numSamples - 1) % capacity + 1;
             }
 
-            mutable int writeIndex{ 0 };
-            std::array<SampleType, capacity> buffer;
+            SampleType* data{ nullptr };
+            int capacity{ 0 };
+            int writeIndex{ 0 };
         };
 
         //==============================================================================================================
-        std::array<BufferWrapper, 2> buffers;
-
-        enum DataFlags
+        static constexpr std::size_t roundUpToCacheLine(std::size_t numBytes) noexcept
         {
-            IDX = 1 << 0,
-            NewData = 1 << 1,
-            Busy = 1 << 2
-        };
+            return (numBytes + cacheLineSize - 1) / cacheLineSize * cacheLineSize;
+        }
 
-        mutable std::atomic<int> idx{ 0 };
+        //==============================================================================================================
+        juce::HeapBlock<char> storage;
+        int currentCapacity{ 0 };
+        mutable std::array<BufferWrapper, 2> buffers;
+        DoubleBufferIndex idx;
     };
 } // namespace jump
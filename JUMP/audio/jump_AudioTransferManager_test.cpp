@@ -0,0 +1,102 @@
+#if JUCE_UNIT_TESTS
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    /** Compares writing whole blocks to an AudioTransferManager with writing the same blocks one sample at a time. */
+    class AudioTransferManagerBlockWriteBenchmark : public juce::UnitTest
+    {
+    public:
+        //==============================================================================================================
+        AudioTransferManagerBlockWriteBenchmark()
+            : juce::UnitTest{ "AudioTransferManager block writes", "Benchmarks" }
+        {
+        }
+
+        //==============================================================================================================
+        void runTest() override
+        {
+            beginTest("Block writes match per-sample writes");
+            {
+                AudioTransferManager<float> blockWrites;
+                AudioTransferManager<float> sampleWrites;
+                blockWrites.setCapacity(800);
+                sampleWrites.setCapacity(800);
+
+                std::vector<float> block(2048);
+                auto& random = getRandom();
+
+                for (auto iteration = 0; iteration < 200; iteration++)
+                {
+                    // Block sizes either side of the capacity, so writes both wrap and overwrite unread samples.
+                    const auto numSamples = 1 + random.nextInt(static_cast<int>(block.size()));
+
+                    for (auto i = 0; i < numSamples; i++)
+                        block[static_cast<std::size_t>(i)] = random.nextFloat();
+
+                    blockWrites.write(block.data(), numSamples);
+
+                    for (auto i = 0; i < numSamples; i++)
+                        sampleWrites.write(block[static_cast<std::size_t>(i)]);
+
+                    if (random.nextInt(3) == 0)
+                        expect(blockWrites.read() == sampleWrites.read());
+                }
+
+                expect(blockWrites.read() == sampleWrites.read());
+            }
+
+            beginTest("Per-block cost");
+            {
+                for (const auto blockSize : { 64, 512, 2048 })
+                {
+                    const auto perSampleCost = measureCostPerBlock(blockSize, [](auto& manager, auto& block) {
+                        for (const auto sample : block)
+                            manager.write(sample);
+                    });
+                    const auto blockCost = measureCostPerBlock(blockSize, [](auto& manager, auto& block) {
+                        manager.write(block.data(), static_cast<int>(block.size()));
+                    });
+
+                    // Only reported rather than asserted on, since wall-clock timings depend on the machine and build.
+                    logMessage(juce::String{ blockSize } + " samples: " + juce::String{ perSampleCost * 1.0e6, 1 }
+                               + "ns per block writing each sample, " + juce::String{ blockCost * 1.0e6, 1 }
+                               + "ns per block writing the whole block");
+                }
+            }
+        }
+
+    private:
+        //==============================================================================================================
+        /** Returns the average time, in milliseconds, taken by the given function to write one block. */
+        template <typename WriteFunction>
+        double measureCostPerBlock(int blockSize, WriteFunction&& writeBlock)
+        {
+            static constexpr auto numBlocks = 20000;
+
+            AudioTransferManager<float> manager;
+            manager.setCapacity(4096);
+
+            std::vector<float> block(static_cast<std::size_t>(blockSize), 0.5f);
+            std::vector<float> readBuffer(static_cast<std::size_t>(manager.getCapacity()));
+
+            const auto start = juce::Time::getMillisecondCounterHiRes();
+
+            for (auto i = 0; i < numBlocks; i++)
+            {
+                writeBlock(manager, block);
+
+                // Read every so often, as a GUI would, so the benchmark includes the handshake with the reader.
+                if (i % 4 == 0)
+                    manager.read(readBuffer.data(), static_cast<int>(readBuffer.size()));
+            }
+
+            return (juce::Time::getMillisecondCounterHiRes() - start) / numBlocks;
+        }
+    };
+
+    static AudioTransferManagerBlockWriteBenchmark audioTransferManagerBlockWriteBenchmark;
+} // namespace jump
+
+#endif
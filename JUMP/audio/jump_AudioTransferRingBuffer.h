@@ -0,0 +1,269 @@
+#pragma once
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    /** A wait-free, single-producer/single-consumer alternative to AudioTransferManager.
+
+        Where AudioTransferManager silently overwrites unread samples once its capacity is reached, this container
+        refuses samples that don't fit and keeps count of them instead, so a reader can tell when it's falling behind
+        (e.g. because the GUI thread stalled for a few hundred milliseconds).
+
+        Exactly one thread may write to the container and exactly one thread may read from it. Neither side ever
+        blocks or retries - each write and each read is a fixed number of atomic loads and stores. The read and write
+        positions live on separate cache lines so the producer and consumer don't invalidate each other's caches on
+        every call.
+
+        @tparam SampleType  The data type of samples to use (usually float or double).
+        @tparam capacity    The maximum number of unread samples the container can hold. As with AudioTransferManager,
+                            this should be at least the maximum expected sample rate divided by the rate at which you're
+                            reading, plus some headroom for a stalled reader.
+    */
+    template <typename SampleType, int capacity>
+    class AudioTransferRingBuffer
+    {
+    public:
+        //==============================================================================================================
+        /** Default constructor.
+
+            Creates an empty container.
+        */
+        AudioTransferRingBuffer()
+        {
+        }
+
+        /** Copy constructor.
+
+            Copies state and values from other. This is not thread safe so should only be used while neither object is
+            being written to or read from.
+
+            @param other    The other ring buffer to copy from.
+        */
+        AudioTransferRingBuffer(const AudioTransferRingBuffer& other)
+            : buffer{ other.buffer }
+        {
+            writePosition.value = other.writePosition.value.load();
+            readPosition.value = other.readPosition.value.load();
+            numDroppedSamples = other.numDroppedSamples.load();
+            numOverruns = other.numOverruns.load();
+        }
+
+        ~AudioTransferRingBuffer()
+        {
+            static_assert(std::is_trivially_copyable<SampleType>::value,
+                          "'SampleType' for AudioTransferRingBuffer must be trivially copyable.");
+            static_assert(capacity > 0, "AudioTransferRingBuffer's capacity must be positive!");
+        }
+
+        //==============================================================================================================
+        /** Writes a single sample to the container.
+
+            If the container is full the sample is dropped and counted as such - see getNumDroppedSamples().
+
+            This should only ever be called from the producer thread.
+
+            @param sample   The sample to write to the container.
+        */
+        void write(SampleType sample)
+        {
+            write(&sample, 1);
+        }
+
+        /** Writes a block of samples to the container.
+
+            If there isn't enough space for the whole block, as many samples as will fit are written and the remainder
+            are dropped and counted as such - see getNumDroppedSamples() and getNumOverruns().
+
+            This should only ever be called from the producer thread.
+
+            @param samples      A pointer to the first sample to write.
+            @param numSamples   The number of samples to write.
+        */
+        void write(const SampleType* samples, int numSamples)
+        {
+            jassert(numSamples >= 0);
+
+            const auto start = writePosition.value.load(std::memory_order_relaxed);
+            const auto end = readPosition.value.load(std::memory_order_acquire) + static_cast<std::size_t>(capacity);
+            const auto numToWrite = juce::jmin(static_cast<std::size_t>(numSamples), end - start);
+
+            if (numToWrite < static_cast<std::size_t>(numSamples))
+            {
+                // Only this thread ever modifies the counters so there's no need for a read-modify-write here.
+                const auto numDropped = static_cast<std::size_t>(numSamples) - numToWrite;
+                numDroppedSamples.store(numDroppedSamples.load(std::memory_order_relaxed) + numDropped,
+                                        std::memory_order_relaxed);
+                numOverruns.store(numOverruns.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+
+            const auto offset = start % static_cast<std::size_t>(capacity);
+            const auto numBeforeWrap = juce::jmin(numToWrite, static_cast<std::size_t>(capacity) - offset);
+
+            std::memcpy(buffer.data() + offset, samples, numBeforeWrap * sizeof(SampleType));
+            std::memcpy(buffer.data(), samples + numBeforeWrap, (numToWrite - numBeforeWrap) * sizeof(SampleType));
+
+            writePosition.value.store(start + numToWrite, std::memory_order_release);
+        }
+
+        /** Returns a vector containing all new samples added to this container since it was last read from (or, if it
+            hasn't been read from yet, since it was created).
+
+            As this allocates a new vector on every call, prefer one of the other read() overloads for regular reads.
+
+            This should only ever be called from the consumer thread.
+
+            @returns    A vector containing the latest samples, oldest first.
+        */
+        std::vector<SampleType> read()
+        {
+            std::vector<SampleType> result;
+
+            read([&result](const SampleType* samples, int numSamples) {
+                result.insert(result.end(), samples, samples + numSamples);
+            });
+
+            return result;
+        }
+
+        /** Passes all new samples added to this container since it was last read from to the given visitor, without
+            copying or allocating.
+
+            The visitor is called with a pointer to the samples and the number of samples, oldest first. It's called
+            once for each contiguous segment of the ring (so at most twice) and isn't called at all if there are no new
+            samples. The pointer is only valid for the duration of the call.
+
+            This should only ever be called from the consumer thread.
+
+            @param visitor  A callable with the signature void(const SampleType*, int).
+
+            @returns    The total number of samples passed to the visitor.
+        */
+        template <typename Visitor>
+        int read(Visitor&& visitor)
+        {
+            return consumeMostRecent(capacity, std::forward<Visitor>(visitor));
+        }
+
+        /** Copies all new samples added to this container since it was last read from into the given destination,
+            without allocating.
+
+            If there are more new samples than will fit in the destination, only the most recent ones are copied. The
+            older ones are still consumed.
+
+            This should only ever be called from the consumer thread.
+
+            @param destination      The array to copy the samples to, oldest first.
+            @param maxNumSamples    The number of samples the destination has space for.
+
+            @returns    The number of samples copied to the destination.
+        */
+        int read(SampleType* destination, int maxNumSamples)
+        {
+            auto numCopied = 0;
+
+            return consumeMostRecent(maxNumSamples, [&](const SampleType* samples, int numSamples) {
+                std::memcpy(destination + numCopied, samples, static_cast<std::size_t>(numSamples) * sizeof(SampleType));
+                numCopied += numSamples;
+            });
+        }
+
+        /** Copies all new samples added to this container since it was last read from into a channel of the given
+            buffer, without allocating.
+
+            If there are more new samples than will fit in the buffer, only the most recent ones are copied.
+
+            This should only ever be called from the consumer thread.
+
+            @param destination  The buffer to copy the samples to, oldest first.
+            @param channel      The channel of the buffer to copy the samples to.
+
+            @returns    The number of samples copied to the buffer.
+        */
+        int read(juce::AudioBuffer<SampleType>& destination, int channel)
+        {
+            return read(destination.getWritePointer(channel), destination.getNumSamples());
+        }
+
+        //==============================================================================================================
+        /** Returns the number of samples that are waiting to be read.
+
+            This is only a snapshot - if called from the consumer thread the true value can only grow, if called from
+            the producer thread it can only shrink.
+        */
+        int getNumAvailableSamples() const noexcept
+        {
+            const auto end = writePosition.value.load(std::memory_order_acquire);
+            const auto start = readPosition.value.load(std::memory_order_acquire);
+
+            return static_cast<int>(end - start);
+        }
+
+        /** Returns the total number of samples that have been dropped because the container was full.
+
+            The count only ever increases so readers wanting to know whether they've fallen behind since they last
+            checked should compare against the previous value. This can safely be called from any thread.
+        */
+        std::uint64_t getNumDroppedSamples() const noexcept
+        {
+            return numDroppedSamples.load(std::memory_order_relaxed);
+        }
+
+        /** Returns the total number of writes that couldn't fit all of their samples in the container.
+
+            Like getNumDroppedSamples(), this only ever increases and can safely be called from any thread.
+        */
+        std::uint64_t getNumOverruns() const noexcept
+        {
+            return numOverruns.load(std::memory_order_relaxed);
+        }
+
+        /** Returns the capacity of this container. */
+        constexpr int getCapacity() const noexcept
+        {
+            return capacity;
+        }
+
+    private:
+        //==============================================================================================================
+        /** Marks every unread sample as read, passing only the most recent maxNumSamples of them to the visitor. */
+        template <typename Visitor>
+        int consumeMostRecent(int maxNumSamples, Visitor&& visitor)
+        {
+            jassert(maxNumSamples >= 0);
+
+            const auto end = writePosition.value.load(std::memory_order_acquire);
+            const auto numToRead = juce::jmin(end - readPosition.value.load(std::memory_order_relaxed),
+                                              static_cast<std::size_t>(maxNumSamples));
+            const auto start = end - numToRead;
+
+            const auto offset = start % static_cast<std::size_t>(capacity);
+            const auto numBeforeWrap = juce::jmin(numToRead, static_cast<std::size_t>(capacity) - offset);
+
+            if (numBeforeWrap > 0)
+                visitor(buffer.data() + offset, static_cast<int>(numBeforeWrap));
+
+            if (numToRead > numBeforeWrap)
+                visitor(buffer.data(), static_cast<int>(numToRead - numBeforeWrap));
+
+            readPosition.value.store(end, std::memory_order_release);
+
+            return static_cast<int>(numToRead);
+        }
+
+        //==============================================================================================================
+        struct alignas(cacheLineSize) PaddedPosition
+        {
+            std::atomic<std::size_t> value{ 0 };
+        };
+
+        //==============================================================================================================
+        PaddedPosition writePosition;
+        PaddedPosition readPosition;
+
+        alignas(cacheLineSize) std::atomic<std::uint64_t> numDroppedSamples{ 0 };
+        std::atomic<std::uint64_t> numOverruns{ 0 };
+
+        alignas(cacheLineSize) std::array<SampleType, static_cast<std::size_t>(capacity)> buffer;
+    };
+} // namespace jump
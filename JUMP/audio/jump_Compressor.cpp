@@ -114,9 +114,9 @@ namespace jump
         return releaseMs;
     }
 
-    const Level<float>& Compressor::getGainReduction() const noexcept
+    Level<float> Compressor::getGainReduction() const noexcept
     {
-        return gainReduction;
+        return publishedGainReduction.read();
     }
 
     //==================================================================================================================
@@ -125,7 +125,10 @@ namespace jump
         jassert(newGainReduction.toGain() >= 0.f);
 
         if (changeValue(gainReduction, newGainReduction))
+        {
+            publishedGainReduction.write(gainReduction);
             gainReductionChanged();
+        }
     }
 
     //==================================================================================================================
@@ -33,7 +33,11 @@ namespace jump
         void setRelease(float releaseTimeMs);
         float getRelease() const noexcept;
 
-        const Level<float>& getGainReduction() const noexcept;
+        /** Returns the most recent gain reduction applied by the compressor.
+
+            This is safe to call from any thread while the compressor is processing.
+        */
+        Level<float> getGainReduction() const noexcept;
 
     protected:
         //==============================================================================================================
@@ -66,6 +70,7 @@ namespace jump
         float attackMs{ 0.f };
         float releaseMs{ 0.f };
         Level<float> gainReduction{ jump::Level<float>::fromGain(1.f) };
+        LatestValueTransfer<Level<float>> publishedGainReduction{ gainReduction };
 
         //==============================================================================================================
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Compressor)
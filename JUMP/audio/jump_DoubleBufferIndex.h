@@ -0,0 +1,90 @@
+#pragma once
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    /** Implements the handshake used by the double-buffered transfer containers (e.g. AudioTransferManager) to decide
+        which of their two buffers the writer may write to and which the reader may read from.
+
+        The writer never waits - it simply flags the index as busy while it writes. The reader only swaps the buffers
+        when new data has been written, spinning briefly if the writer is part-way through a write.
+    */
+    class DoubleBufferIndex
+    {
+    public:
+        //==============================================================================================================
+        /** Default constructor. */
+        DoubleBufferIndex() = default;
+
+        /** Copy constructor.
+
+            Copies the current state of other.
+        */
+        DoubleBufferIndex(const DoubleBufferIndex& other)
+            : idx{ other.idx.load() }
+        {
+        }
+
+        //==============================================================================================================
+        /** Marks the index as busy and returns the index of the buffer the writer should write to.
+
+            Every call to this must be followed by a call to endWrite() once the writer has finished writing.
+        */
+        std::size_t beginWrite() noexcept
+        {
+            return static_cast<std::size_t>(idx.fetch_or(DataFlags::Busy) & DataFlags::IDX);
+        }
+
+        /** Publishes the data written since beginWrite() and marks the index as no longer busy.
+
+            @param writeIndex   The index returned by the matching call to beginWrite().
+        */
+        void endWrite(std::size_t writeIndex) noexcept
+        {
+            idx.store((static_cast<int>(writeIndex) & DataFlags::IDX) | DataFlags::NewData);
+        }
+
+        /** Swaps the buffers if new data has been written since the last read and returns the index of the buffer that's
+            safe to read from.
+        */
+        std::size_t acquireReadIndex() const noexcept
+        {
+            // Get the current state of the idx.
+            auto currentIDX = idx.load();
+
+            // Check if new data has been added since the last read.
+            if ((currentIDX & DataFlags::NewData) != 0)
+            {
+                auto newValue = -1;
+
+                // CAS loop.
+                // Keep looping until the idx is no longer busy.
+                do
+                {
+                    currentIDX &= ~DataFlags::Busy;
+                    newValue = (currentIDX ^ DataFlags::IDX) & DataFlags::IDX;
+                }
+                while (!idx.compare_exchange_weak(currentIDX, newValue));
+
+                // Something went wrong here - the value never got changed!
+                jassert(newValue != -1);
+
+                currentIDX = newValue;
+            }
+
+            return static_cast<std::size_t>((currentIDX & DataFlags::IDX) ^ 1);
+        }
+
+    private:
+        //==============================================================================================================
+        enum DataFlags
+        {
+            IDX = 1 << 0,
+            NewData = 1 << 1,
+            Busy = 1 << 2
+        };
+
+        mutable std::atomic<int> idx{ 0 };
+    };
+} // namespace jump
@@ -0,0 +1,128 @@
+#pragma once
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    /** Publishes the latest value of a small, trivially copyable object from a real-time thread to other threads.
+
+        This is intended for telemetry where only the most recent value matters - gain reduction, meter peaks and the
+        like - and where a reader should never see a value that's half-way through being written.
+
+        It's implemented as a sequence lock: the single writer bumps a sequence counter before and after each write,
+        and readers retry if the counter changed (or was odd) while they were copying. Writing never blocks and never
+        loops so it's safe to call from the audio thread. The payload is stored as a set of atomic words so the
+        copying is free of data races, and the whole object sits on its own cache line(s) so it doesn't share a line
+        with unrelated data.
+
+        @tparam ValueType   The type of value to publish. This must be trivially copyable and default constructible.
+    */
+    template <typename ValueType>
+    class alignas(cacheLineSize) LatestValueTransfer
+    {
+    public:
+        //==============================================================================================================
+        /** Creates a container holding the given value. */
+        explicit LatestValueTransfer(const ValueType& initialValue = ValueType{})
+        {
+            write(initialValue);
+            lastReadSequence.store(sequence.load());
+        }
+
+        ~LatestValueTransfer()
+        {
+            static_assert(std::is_trivially_copyable<ValueType>::value,
+                          "'ValueType' for jump::LatestValueTransfer must be trivially copyable.");
+        }
+
+        //==============================================================================================================
+        /** Publishes a new value.
+
+            This should only ever be called from a single thread (usually the audio thread).
+        */
+        void write(const ValueType& newValue) noexcept
+        {
+            std::array<Word, numWords> newWords{};
+            std::memcpy(newWords.data(), &newValue, sizeof(ValueType));
+
+            const auto currentSequence = sequence.load(std::memory_order_relaxed);
+            sequence.store(currentSequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            for (std::size_t i = 0; i < numWords; i++)
+                words[i].store(newWords[i], std::memory_order_relaxed);
+
+            sequence.store(currentSequence + 2, std::memory_order_release);
+        }
+
+        /** Returns the most recently published value.
+
+            This will only ever retry if a write happens part-way through reading, which for small values at GUI
+            rates is vanishingly rare.
+        */
+        ValueType read() const noexcept
+        {
+            for (;;)
+            {
+                const auto sequenceBefore = sequence.load(std::memory_order_acquire);
+
+                if ((sequenceBefore & 1) != 0)
+                    continue;
+
+                std::array<Word, numWords> currentWords;
+
+                for (std::size_t i = 0; i < numWords; i++)
+                    currentWords[i] = words[i].load(std::memory_order_relaxed);
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                if (sequence.load(std::memory_order_relaxed) != sequenceBefore)
+                    continue;
+
+                lastReadSequence.store(sequenceBefore, std::memory_order_relaxed);
+
+                ValueType result;
+                std::memcpy(static_cast<void*>(&result), currentWords.data(), sizeof(ValueType));
+
+                return result;
+            }
+        }
+
+        /** Returns true if a new value has been published since read() was last called.
+
+            The flag is shared between all readers so this is only meaningful when there's a single reader.
+        */
+        bool hasChanged() const noexcept
+        {
+            return sequence.load(std::memory_order_acquire) != lastReadSequence.load(std::memory_order_relaxed);
+        }
+
+        /** Copies the latest value into the given destination, but only if it's changed since the last read.
+
+            @returns True if a new value was copied.
+        */
+        bool readIfChanged(ValueType& destination) const noexcept
+        {
+            if (!hasChanged())
+                return false;
+
+            destination = read();
+            return true;
+        }
+
+    private:
+        //==============================================================================================================
+        using Word = std::uint32_t;
+        static constexpr std::size_t numWords = (sizeof(ValueType) + sizeof(Word) - 1) / sizeof(Word);
+
+        //==============================================================================================================
+        std::atomic<std::uint32_t> sequence{ 0 };
+        std::array<std::atomic<Word>, numWords> words{};
+
+        // Only written by readers, so kept away from the line the writer touches.
+        alignas(cacheLineSize) mutable std::atomic<std::uint32_t> lastReadSequence{ 0 };
+
+        //==============================================================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LatestValueTransfer)
+    };
+} // namespace jump
@@ -9,25 +9,15 @@ namespace jump
     {
     public:
         //==============================================================================================================
-        Level() = default;
-
-        Level(const Level& other)
-            : gain{ other.gain }
-            , decibels{ other.decibels }
-        {
-        }
-
-        Level(Level&& other)
-            : gain{ other.gain }
-            , decibels{ other.decibels }
-        {
-        }
+        // Level itself is kept trivially copyable so it can be published between threads by LatestValueTransfer.
+        static_assert(std::is_trivially_copyable<ValueType>::value,
+                      "`ValueType` for jump::Level<ValueType> must be trivially copyable!");
 
-        ~Level()
-        {
-            static_assert(std::is_trivially_copyable<ValueType>::value,
-                          "`ValueType` for jump::Level<ValueType> must be trivially copyable!");
-        }
+        //==============================================================================================================
+        Level() = default;
+        Level(const Level& other) = default;
+        Level(Level&& other) = default;
+        ~Level() = default;
 
         //==============================================================================================================
         ValueType toGain() const noexcept
@@ -61,13 +51,8 @@ namespace jump
         }
 
         //==============================================================================================================
-        Level& operator=(const Level& other)
-        {
-            gain = other.gain;
-            decibels = other.decibels;
-
-            return *this;
-        }
+        Level& operator=(const Level& other) = default;
+        Level& operator=(Level&& other) = default;
 
         bool operator==(const Level& other) const
         {
@@ -0,0 +1,83 @@
+#pragma once
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    /** A compact summary of the levels in a block of samples.
+
+        Level meters don't need every raw sample to be shipped from the audio thread to the GUI thread - the peak and
+        the sum of squares of each block are enough to drive both peak and RMS envelopes. Summarising each block on the
+        audio thread and transferring these records instead of the samples themselves (e.g. using an
+        AudioTransferManager<LevelSummary, capacity>) cuts the amount of data moved between threads by a factor of the
+        block size.
+
+        @code
+        // Audio thread:
+        summaries.write(jump::LevelSummary::fromSamples(buffer.getReadPointer(0), buffer.getNumSamples()));
+
+        // GUI thread:
+        summaries.read([this](const jump::LevelSummary* newSummaries, int numSummaries) {
+            meterEngine.addSummaries(newSummaries, numSummaries);
+        });
+        @endcode
+    */
+    struct LevelSummary
+    {
+        //==============================================================================================================
+        /** Summarises the given block of samples.
+
+            The minimum and maximum are found using juce::FloatVectorOperations and the sum of squares is accumulated in
+            several independent lanes so the whole summary stays cheap enough to compute on the audio thread.
+
+            @param samples      A pointer to the first sample in the block.
+            @param numSamples   The number of samples in the block.
+        */
+        static LevelSummary fromSamples(const float* samples, int numSamples)
+        {
+            LevelSummary summary;
+
+            if (numSamples <= 0)
+                return summary;
+
+            const auto range = juce::FloatVectorOperations::findMinAndMax(samples, numSamples);
+            summary.min = range.getStart();
+            summary.max = range.getEnd();
+            summary.maxAbs = juce::jmax(std::abs(summary.min), std::abs(summary.max));
+
+            std::array<float, 4> lanes{};
+            auto i = 0;
+
+            for (; i + 4 <= numSamples; i += 4)
+            {
+                for (std::size_t lane = 0; lane < lanes.size(); lane++)
+                {
+                    const auto sample = samples[i + static_cast<int>(lane)];
+                    lanes[lane] += sample * sample;
+                }
+            }
+
+            for (; i < numSamples; i++)
+                lanes[0] += samples[i] * samples[i];
+
+            summary.sumOfSquares = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+            summary.numSamples = numSamples;
+
+            return summary;
+        }
+
+        //==============================================================================================================
+        /** Returns the mean of the squares of the summarised samples. */
+        float getMeanSquare() const noexcept
+        {
+            return numSamples > 0 ? sumOfSquares / static_cast<float>(numSamples) : 0.f;
+        }
+
+        //==============================================================================================================
+        float maxAbs{ 0.f };
+        float sumOfSquares{ 0.f };
+        float min{ 0.f };
+        float max{ 0.f };
+        int numSamples{ 0 };
+    };
+} // namespace jump
@@ -0,0 +1,259 @@
+#pragma once
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    /** Manages the transfer of a multichannel stream of audio samples from a real-time thread to a non real-time
+        thread (e.g. getting samples from an audio thread to a GUI thread).
+
+        This works in the same way as AudioTransferManager but stores all channels in planar buffers that share a
+        single write index, so every channel of a block is published with a single atomic handshake and a reader
+        always receives the same span of time for every channel.
+
+        A typical use is to write the processor's buffer from the audio thread and then, from a GUI timer, dispatch
+        each channel to its own engine:
+
+        @code
+        transferManager.read([this](const juce::dsp::AudioBlock<const float>& block) {
+            for (auto channel = 0; channel < static_cast<int>(block.getNumChannels()); channel++)
+            {
+                engines[channel]->addSamples(block.getChannelPointer(static_cast<std::size_t>(channel)),
+                                             static_cast<int>(block.getNumSamples()));
+            }
+        });
+        @endcode
+
+        @tparam SampleType      The data type of samples to use (usually float or double).
+        @tparam initialCapacity The initial maximum number of samples per channel allowed in each of the two internal
+                                buffers. If this is zero, the capacity must be set by prepare() before the container
+                                can be written to. See AudioTransferManager for advice on choosing a suitable capacity.
+    */
+    template <typename SampleType, int initialCapacity = 0>
+    class MultichannelAudioTransferManager
+    {
+    public:
+        //==============================================================================================================
+        /** Creates a container for the given number of channels.
+
+            @param numChannels  The number of channels to allocate space for.
+        */
+        explicit MultichannelAudioTransferManager(int numChannels = 0)
+        {
+            prepare(numChannels);
+        }
+
+        ~MultichannelAudioTransferManager()
+        {
+            static_assert(std::is_trivially_copyable<SampleType>::value,
+                          "'SampleType' for MultichannelAudioTransferManager must be trivially copyable.");
+            static_assert(initialCapacity >= 0, "MultichannelAudioTransferManager's capacity must be positive!");
+        }
+
+        //==============================================================================================================
+        /** Changes the number of channels and discards any unread samples.
+
+            This allocates so should be called from somewhere like prepareToPlay() and never while the container is
+            being written to or read from.
+
+            @param newNumChannels   The number of channels to allocate space for.
+        */
+        void prepare(int newNumChannels)
+        {
+            allocate(newNumChannels, capacity);
+        }
+
+        /** Changes the number of channels and sizes the container so it can hold every sample written between two
+            reads, discarding any unread samples.
+
+            Like prepare(int), this allocates so should only be called while the container isn't in use.
+
+            @param newNumChannels   The number of channels to allocate space for.
+            @param sampleRate       The rate at which samples will be written.
+            @param readRateHz       The rate at which the container will be read from, e.g. the frequency of a GUI
+                                    timer.
+            @param maxBlockSize     The largest number of samples per channel that will be written in one go.
+
+            @see AudioTransferManager::getRequiredCapacity()
+        */
+        void prepare(int newNumChannels, double sampleRate, double readRateHz, int maxBlockSize)
+        {
+            allocate(newNumChannels,
+                     AudioTransferManager<SampleType>::getRequiredCapacity(sampleRate, readRateHz, maxBlockSize));
+        }
+
+        /** Returns the number of channels this container was prepared with. */
+        int getNumChannels() const noexcept
+        {
+            return buffers[0].samples.getNumChannels();
+        }
+
+        /** Returns the capacity, per channel, of this container. */
+        int getCapacity() const noexcept
+        {
+            return capacity;
+        }
+
+        //==============================================================================================================
+        /** Writes a block of samples to the container.
+
+            All channels are published together with a single handshake with the reader. If the number of samples
+            written since the container was last read from reaches capacity, old, unread samples will be overwritten.
+
+            The block should have the same number of channels as the container. Any extra channels are ignored, and if
+            the block has fewer channels, the container's remaining channels are written as silence for the span of
+            the block.
+
+            @param block    The block of samples to write.
+        */
+        void write(const juce::dsp::AudioBlock<const SampleType>& block)
+        {
+            // The container needs to be given a capacity before it can be written to!
+            jassert(capacity > 0);
+
+            if (block.getNumSamples() == 0 || capacity <= 0)
+                return;
+
+            const auto writeIndex = idx.beginWrite();
+            buffers[writeIndex].write(block);
+            idx.endWrite(writeIndex);
+        }
+
+        /** Writes a buffer of samples to the container.
+
+            @see write(const juce::dsp::AudioBlock<const SampleType>&)
+        */
+        void write(const juce::AudioBuffer<SampleType>& buffer)
+        {
+            write(juce::dsp::AudioBlock<const SampleType>{ buffer });
+        }
+
+        /** Passes all new samples added to this container since it was last read from to the given visitor, without
+            copying or allocating.
+
+            The visitor is called with a single block containing the same span of time for every channel, oldest sample
+            first. It isn't called at all if there are no new samples. The block is only valid for the duration of the
+            call.
+
+            @param visitor  A callable with the signature void(const juce::dsp::AudioBlock<const SampleType>&).
+
+            @returns    The number of samples, per channel, passed to the visitor.
+        */
+        template <typename Visitor>
+        int read(Visitor&& visitor) const
+        {
+            auto& buffer = buffers[idx.acquireReadIndex()];
+            const auto numSamples = buffer.writeIndex;
+
+            if (numSamples > 0)
+            {
+                const juce::dsp::AudioBlock<const SampleType> block{ buffer.samples };
+                visitor(block.getSubBlock(0, static_cast<std::size_t>(numSamples)));
+            }
+
+            buffer.writeIndex = 0;
+
+            return numSamples;
+        }
+
+        /** Copies all new samples added to this container since it was last read from into the given buffer, without
+            allocating.
+
+            If there are more new samples than will fit in the buffer, only the most recent ones are copied. Only as
+            many channels as both this container and the buffer have are copied.
+
+            @param destination  The buffer to copy the samples to, oldest first.
+
+            @returns    The number of samples, per channel, copied to the buffer.
+        */
+        int read(juce::AudioBuffer<SampleType>& destination) const
+        {
+            auto numCopied = 0;
+
+            read([&](const juce::dsp::AudioBlock<const SampleType>& block) {
+                const auto numSamples = static_cast<int>(block.getNumSamples());
+                numCopied = juce::jmin(numSamples, destination.getNumSamples());
+
+                const auto numChannels = juce::jmin(static_cast<int>(block.getNumChannels()),
+                                                    destination.getNumChannels());
+
+                for (auto channel = 0; channel < numChannels; channel++)
+                {
+                    const auto* source = block.getChannelPointer(static_cast<std::size_t>(channel));
+                    std::memcpy(destination.getWritePointer(channel),
+                                source + (numSamples - numCopied),
+                                static_cast<std::size_t>(numCopied) * sizeof(SampleType));
+                }
+            });
+
+            return numCopied;
+        }
+
+    private:
+        //==============================================================================================================
+        void allocate(int newNumChannels, int newCapacity)
+        {
+            jassert(newNumChannels >= 0 && newCapacity >= 0);
+
+            capacity = juce::jmax(newCapacity, 0);
+
+            for (auto& buffer : buffers)
+            {
+                buffer.samples.setSize(newNumChannels, capacity);
+                buffer.samples.clear();
+                buffer.writeIndex = 0;
+            }
+        }
+
+        //==============================================================================================================
+        /** Implements the logic for writing to a planar buffer with a write index shared by all of its channels. */
+        struct BufferWrapper
+        {
+            void write(const juce::dsp::AudioBlock<const SampleType>& block)
+            {
+                const auto numSamples = static_cast<int>(block.getNumSamples());
+                const auto capacity = samples.getNumSamples();
+
+                // Only the most recent samples can survive the wrap so there's no point copying any others.
+                const auto numToCopy = juce::jmin(numSamples, capacity);
+                const auto start = (writeIndex + numSamples - numToCopy) % capacity;
+                const auto numBeforeWrap = juce::jmin(numToCopy, capacity - start);
+
+                const auto numBlockChannels = juce::jmin(static_cast<int>(block.getNumChannels()),
+                                                         samples.getNumChannels());
+
+                for (auto channel = 0; channel < samples.getNumChannels(); channel++)
+                {
+                    // Channels the block doesn't have are kept time-aligned with the others by writing silence.
+                    if (channel >= numBlockChannels)
+                    {
+                        samples.clear(channel, start, numBeforeWrap);
+                        samples.clear(channel, 0, numToCopy - numBeforeWrap);
+                        continue;
+                    }
+
+                    const auto* source = block.getChannelPointer(static_cast<std::size_t>(channel))
+                                       + (numSamples - numToCopy);
+                    auto* destination = samples.getWritePointer(channel);
+
+                    std::memcpy(destination + start, source, static_cast<std::size_t>(numBeforeWrap) * sizeof(SampleType));
+                    std::memcpy(destination, source + numBeforeWrap,
+                                static_cast<std::size_t>(numToCopy - numBeforeWrap) * sizeof(SampleType));
+                }
+
+                writeIndex = (writeIndex + numSamples - 1) % capacity + 1;
+            }
+
+            int writeIndex{ 0 };
+            juce::AudioBuffer<SampleType> samples;
+        };
+
+        //==============================================================================================================
+        int capacity{ initialCapacity };
+        mutable std::array<BufferWrapper, 2> buffers;
+        DoubleBufferIndex idx;
+
+        //==============================================================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MultichannelAudioTransferManager)
+    };
+} // namespace jump
@@ -0,0 +1,64 @@
+#if JUCE_UNIT_TESTS
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    class MultichannelAudioTransferManagerTests : public juce::UnitTest
+    {
+    public:
+        //==============================================================================================================
+        MultichannelAudioTransferManagerTests()
+            : juce::UnitTest{ "MultichannelAudioTransferManager", "Audio" }
+        {
+        }
+
+        //==============================================================================================================
+        void runTest() override
+        {
+            beginTest("Channels missing from a block are written as silence");
+            {
+                static constexpr auto numChannels = 3;
+                static constexpr auto capacity = 64;
+
+                MultichannelAudioTransferManager<float, capacity> transferManager{ numChannels };
+                juce::AudioBuffer<float> destination{ numChannels, capacity };
+
+                // Fill every channel first so any channel that isn't written to would still hold these samples.
+                writeBlock(transferManager, numChannels, capacity, 1.f);
+                transferManager.read(destination);
+
+                // Written in blocks that don't divide the capacity, so the later writes wrap.
+                for (auto i = 0; i < 3; i++)
+                    writeBlock(transferManager, 1, 30, 2.f);
+
+                const auto numSamples = transferManager.read(destination);
+                expectGreaterThan(numSamples, 0);
+
+                for (auto i = 0; i < numSamples; i++)
+                {
+                    expectEquals(destination.getSample(0, i), 2.f);
+                    expectEquals(destination.getSample(1, i), 0.f);
+                    expectEquals(destination.getSample(2, i), 0.f);
+                }
+            }
+        }
+
+    private:
+        //==============================================================================================================
+        template <typename TransferManager>
+        static void writeBlock(TransferManager& transferManager, int numChannels, int numSamples, float value)
+        {
+            juce::AudioBuffer<float> block{ numChannels, numSamples };
+
+            for (auto channel = 0; channel < numChannels; channel++)
+                juce::FloatVectorOperations::fill(block.getWritePointer(channel), value, numSamples);
+
+            transferManager.write(block);
+        }
+    };
+
+    static MultichannelAudioTransferManagerTests multichannelAudioTransferManagerTests;
+} // namespace jump
+
+#endif
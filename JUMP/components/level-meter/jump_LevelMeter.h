@@ -77,6 +77,11 @@ namespace jump
             meter.repaint();
         }
 
+        bool isRendererVisible() const override
+        {
+            return isShowing();
+        }
+
         //==============================================================================================================
         const LevelMeterEngine& engine;
         Orientation orientation{ Orientation::vertical };
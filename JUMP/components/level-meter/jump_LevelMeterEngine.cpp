@@ -27,9 +27,16 @@ namespace jump
     }
 
     //==================================================================================================================
-    void LevelMeterEngine::addSamples(const std::vector<float>& samples)
+    void LevelMeterEngine::addSamples(const float* samples, int numSamples)
     {
-        buffer.insert(std::end(buffer), std::begin(samples), std::end(samples));
+        // The buffer is cleared, not shrunk, after each update so this only allocates until it reaches its high-water
+        // mark.
+        buffer.insert(std::end(buffer), samples, samples + numSamples);
+    }
+
+    void LevelMeterEngine::addSummaries(const LevelSummary* newSummaries, int numSummaries)
+    {
+        summaries.insert(std::end(summaries), newSummaries, newSummaries + numSummaries);
     }
 
     //==================================================================================================================
@@ -101,7 +108,7 @@ namespace jump
 
     void LevelMeterEngine::update(juce::uint32 now)
     {
-        if (!rmsFilterIsPrepared || buffer.size() == 0)
+        if (!rmsFilterIsPrepared || (buffer.size() == 0 && summaries.size() == 0))
             return;
 
         juce::var peak;
@@ -113,10 +120,17 @@ namespace jump
             peak = updatePeak(value, now);
         }
 
+        for (auto& summary : summaries)
+        {
+            rms = updateRMS(summary);
+            peak = updatePeak(summary.maxAbs, now);
+        }
+
         rms = juce::Decibels::gainToDecibels(static_cast<float>(rms), decibelRange.start);
         callRenderers(renderers, this, peak, rms, decibelRange);
 
         buffer.clear();
+        summaries.clear();
     }
 
     void LevelMeterEngine::propertyChanged(const juce::Identifier& name, const juce::var& newValue)
@@ -164,12 +178,43 @@ namespace jump
         return peakDB;
     }
 
+    float LevelMeterEngine::updateRMS(const LevelSummary& summary)
+    {
+        // Equivalent to running the RMS ballistics filter over a block of samples that all have the summary's mean
+        // square value.
+        const auto meanSquare = summary.getMeanSquare();
+        const auto coefficient = meanSquare > summaryMeanSquare ? summaryAttackCoefficient : summaryReleaseCoefficient;
+        const auto blockCoefficient = std::pow(coefficient, static_cast<float>(summary.numSamples));
+
+        summaryMeanSquare = meanSquare + blockCoefficient * (summaryMeanSquare - meanSquare);
+
+        return std::sqrt(summaryMeanSquare);
+    }
+
+    [[nodiscard]] static auto calculateBallisticsCoefficient(float timeMS, double sampleRate)
+    {
+        // This matches the coefficients used by juce::dsp::BallisticsFilter.
+        if (timeMS < 1.0e-3f || sampleRate <= 0.0)
+            return 0.f;
+
+        return static_cast<float>(std::exp(-2.0 * juce::MathConstants<double>::pi * 1000.0 / sampleRate / timeMS));
+    }
+
+    void LevelMeterEngine::updateSummaryCoefficients()
+    {
+        summaryAttackCoefficient = calculateBallisticsCoefficient(rmsAttack, sampleRate);
+        summaryReleaseCoefficient = calculateBallisticsCoefficient(rmsRelease, sampleRate);
+    }
+
     //==================================================================================================================
     void LevelMeterEngine::setSampleRateInternal(double newSampleRate)
     {
         if (newSampleRate <= 0.0)
             return;
 
+        sampleRate = newSampleRate;
+        updateSummaryCoefficients();
+
         juce::dsp::ProcessSpec processSpec{};
         processSpec.sampleRate = newSampleRate;
         processSpec.numChannels = 1;
@@ -183,11 +228,13 @@ namespace jump
     {
         rmsFilter.setAttackTime(newAttackTimeMS);
         rmsAttack = newAttackTimeMS;
+        updateSummaryCoefficients();
     }
 
     void LevelMeterEngine::setRMSReleaseTimeInternal(float newReleaseTimeMS)
     {
         rmsFilter.setReleaseTime(newReleaseTimeMS);
         rmsRelease = newReleaseTimeMS;
+        updateSummaryCoefficients();
     }
 } // namespace jump
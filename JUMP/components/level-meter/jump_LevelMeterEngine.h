@@ -17,6 +17,16 @@ namespace jump
             calculated by the given engine.
         */
         virtual void newLevelMeterLevelsAvailable(const LevelMeterEngine& engine, float peakLevel, float rmsLevel) = 0;
+
+        /** Derived classes can override this method to tell the engine whether they're currently visible to the user.
+
+            Engines whose renderers are all hidden are the first to be slowed down when the EngineScheduler runs over
+            budget. Renderers are assumed to be visible by default.
+        */
+        virtual bool isRendererVisible() const
+        {
+            return true;
+        }
     };
 
     //==================================================================================================================
@@ -46,7 +56,19 @@ namespace jump
         LevelMeterEngine(const juce::Identifier& uniqueID, StatefulObject* parentState);
 
         //==============================================================================================================
-        void addSamples(const std::vector<float>& samples) override;
+        using AudioComponentEngine::addSamples;
+        void addSamples(const float* samples, int numSamples) override;
+
+        /** Adds summaries of blocks of samples, as an alternative to adding the raw samples themselves.
+
+            Summaries are much cheaper to transfer from the audio thread than raw samples. The RMS envelope is applied
+            per summary rather than per sample, so the result is a close approximation of what the raw samples would
+            give. An engine should be fed either summaries or raw samples, not a mix of the two.
+
+            @param summaries    A pointer to the first summary to add.
+            @param numSummaries The number of summaries to add.
+        */
+        void addSummaries(const LevelSummary* summaries, int numSummaries);
 
         //==============================================================================================================
         /** Specifies the sample rate of the samples being added to this engine.
@@ -125,6 +147,8 @@ namespace jump
         //==============================================================================================================
         void initialise();
         float updatePeak(float gainValue, juce::uint32 now);
+        float updateRMS(const LevelSummary& summary);
+        void updateSummaryCoefficients();
 
         //==============================================================================================================
         void setSampleRateInternal(double newSampleRate);
@@ -133,10 +157,16 @@ namespace jump
 
         //==============================================================================================================
         std::vector<float> buffer;
+        std::vector<LevelSummary> summaries;
         juce::dsp::BallisticsFilter<float> rmsFilter;
         bool rmsFilterIsPrepared{ false };
         float rmsAttack{ 0.f };
         float rmsRelease{ 0.f };
+        double sampleRate{ 0.0 };
+
+        float summaryMeanSquare{ 0.f };
+        float summaryAttackCoefficient{ 0.f };
+        float summaryReleaseCoefficient{ 0.f };
 
         float previousPeakDB{ 0.f };
         juce::uint32 timeOfPeakMax{ 0 };
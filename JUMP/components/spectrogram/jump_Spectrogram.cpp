@@ -0,0 +1,191 @@
+#include "jump_Spectrogram.h"
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    Spectrogram::Spectrogram(const SpectrogramEngine& engineToUse)
+        : engine{ engineToUse }
+    {
+        lookAndFeel.onValidLookAndFeelFound = [this]() {
+            updateColourMap();
+        };
+        lookAndFeel.attachTo(this);
+
+        addAndMakeVisible(background);
+        background.setDrawFunction([this](juce::Graphics& g) {
+            lookAndFeel->drawBackground(g, *this);
+        });
+
+        addAndMakeVisible(spectrogram);
+        spectrogram.setDrawFunction([this](juce::Graphics& g) {
+            drawImage(g);
+        });
+
+        engineToUse.addRenderer(this);
+    }
+
+    Spectrogram::~Spectrogram()
+    {
+        engine.removeRenderer(this);
+    }
+
+    //==================================================================================================================
+    const SpectrogramEngine& Spectrogram::getEngine() const noexcept
+    {
+        return engine;
+    }
+
+    //==================================================================================================================
+    void Spectrogram::resized()
+    {
+        const auto bounds = getLocalBounds();
+
+        background.setBounds(bounds);
+
+        // Inset so the spectrogram doesn't cover the background's border.
+        spectrogram.setBounds(bounds.reduced(1));
+
+        redrawHistory();
+    }
+
+    void Spectrogram::colourChanged()
+    {
+        updateColourMap();
+    }
+
+    static bool areRangesEqual(const juce::NormalisableRange<float>& a, const juce::NormalisableRange<float>& b)
+    {
+        return juce::approximatelyEqual(a.start, b.start) && juce::approximatelyEqual(a.end, b.end)
+            && juce::approximatelyEqual(a.skew, b.skew) && a.symmetricSkew == b.symmetricSkew;
+    }
+
+    void Spectrogram::newSpectrogramFrameAvailable(const SpectrogramEngine&)
+    {
+        if (image.isNull())
+            return;
+
+        // The look and feel may colour levels by their Decibel value, so the colour map depends on the range too.
+        if (!isColourMapBuilt || !areRangesEqual(colourMapDecibelRange, engine.getSourceEngine().getDecibelRange()))
+        {
+            updateColourMap();
+            return;
+        }
+
+        // Changing the number of rows clears the engine's history, so the image has to start again too.
+        if (rowLookupNumRows != engine.getNumRows())
+        {
+            redrawHistory();
+            return;
+        }
+
+        drawFrame(engine.getFrame(0));
+        spectrogram.repaint();
+    }
+
+    bool Spectrogram::isRendererVisible() const
+    {
+        return isShowing();
+    }
+
+    //==================================================================================================================
+    void Spectrogram::updateColourMap()
+    {
+        // The colours come from the look and feel, so there's nothing to build them from until one's been found.
+        if (!lookAndFeel)
+            return;
+
+        colourMapDecibelRange = engine.getSourceEngine().getDecibelRange();
+
+        for (std::size_t i = 0; i < colourMap.size(); i++)
+        {
+            const auto level = static_cast<float>(i) / static_cast<float>(colourMap.size() - 1);
+            colourMap[i] = lookAndFeel->getSpectrogramColour(*this, level).getPixelARGB();
+        }
+
+        isColourMapBuilt = true;
+
+        redrawHistory();
+    }
+
+    void Spectrogram::updateRowLookup()
+    {
+        const auto height = juce::jmax(spectrogram.getHeight(), 0);
+        rowLookupNumRows = engine.getNumRows();
+        rowForPixel.resize(static_cast<std::size_t>(height));
+
+        for (auto y = 0; y < height; y++)
+        {
+            // The top of the image is the highest frequency.
+            const auto proportion = 1.f - (static_cast<float>(y) + 0.5f) / static_cast<float>(height);
+            const auto row = static_cast<int>(proportion * static_cast<float>(rowLookupNumRows));
+
+            rowForPixel[static_cast<std::size_t>(y)] = juce::jlimit(0, rowLookupNumRows - 1, row);
+        }
+    }
+
+    void Spectrogram::redrawHistory()
+    {
+        const auto width = spectrogram.getWidth();
+        const auto height = spectrogram.getHeight();
+
+        if (width <= 0 || height <= 0)
+        {
+            image = {};
+            return;
+        }
+
+        updateRowLookup();
+
+        // A software image guarantees the pixels are in memory that can be written to directly, whereas writing to a
+        // native image may involve copying it to and from the graphics card.
+        image = juce::Image{ juce::Image::ARGB, width, height, true, juce::SoftwareImageType{} };
+        nextColumn = 0;
+
+        // Until the colour map has been built the image is left blank - building it redraws the history anyway.
+        if (isColourMapBuilt)
+        {
+            for (auto age = juce::jmin(engine.getNumFramesAvailable(), width) - 1; age >= 0; age--)
+                drawFrame(engine.getFrame(age));
+        }
+
+        spectrogram.repaint();
+    }
+
+    void Spectrogram::drawFrame(const juce::uint8* frame)
+    {
+        {
+            const juce::Image::BitmapData pixels{ image,
+                                                  nextColumn,
+                                                  0,
+                                                  1,
+                                                  image.getHeight(),
+                                                  juce::Image::BitmapData::writeOnly };
+            auto* pixel = pixels.getLinePointer(0);
+
+            for (std::size_t y = 0; y < rowForPixel.size(); y++)
+            {
+                *reinterpret_cast<juce::PixelARGB*>(pixel) = colourMap[frame[rowForPixel[y]]];
+                pixel += pixels.lineStride;
+            }
+        }
+
+        nextColumn = (nextColumn + 1) % image.getWidth();
+    }
+
+    void Spectrogram::drawImage(juce::Graphics& g) const
+    {
+        if (image.isNull())
+            return;
+
+        const auto width = image.getWidth();
+        const auto height = image.getHeight();
+
+        // The next column to be drawn to holds the oldest frame, so the columns from there onwards go on the left.
+        const auto numOldestColumns = width - nextColumn;
+        g.drawImage(image, 0, 0, numOldestColumns, height, nextColumn, 0, numOldestColumns, height);
+
+        if (nextColumn > 0)
+            g.drawImage(image, numOldestColumns, 0, nextColumn, height, 0, 0, nextColumn, height);
+    }
+} // namespace jump
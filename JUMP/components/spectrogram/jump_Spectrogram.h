@@ -0,0 +1,78 @@
+#pragma once
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    /** Draws the history of a SpectrogramEngine as a scrolling spectrogram, with time on the X axis (newest on the
+        right) and frequency on the Y axis.
+
+        Each frame is drawn as a single column of pixels into an image that's kept between frames, so each new frame
+        only costs one column of pixels, coloured through a 256-entry lookup table, no matter how much history is on
+        screen. Rather than moving the existing pixels along, the image is used as a ring of columns and is drawn in two
+        parts so that the oldest column always appears on the left.
+    */
+    class Spectrogram
+        : public Container
+        , public SpectrogramRendererBase
+    {
+    public:
+        //==============================================================================================================
+        struct LookAndFeelMethods
+        {
+            virtual ~LookAndFeelMethods() = default;
+
+            virtual void drawBackground(juce::Graphics& g, const Spectrogram& spectrogram) const noexcept = 0;
+
+            /** Returns the colour to draw the given normalised level with.
+
+                This is called for 256 evenly spaced levels to build the spectrogram's lookup table whenever its look
+                and feel, its colours or the source engine's Decibel range change, rather than for each pixel that's
+                drawn.
+            */
+            virtual juce::Colour getSpectrogramColour(const Spectrogram& spectrogram,
+                                                      float normalisedLevel) const noexcept = 0;
+        };
+
+        //==============================================================================================================
+        explicit Spectrogram(const SpectrogramEngine& engineToUse);
+        ~Spectrogram() override;
+
+        //==============================================================================================================
+        const SpectrogramEngine& getEngine() const noexcept;
+
+    private:
+        //==============================================================================================================
+        void resized() override;
+        void colourChanged() override;
+        void newSpectrogramFrameAvailable(const SpectrogramEngine&) override;
+        bool isRendererVisible() const override;
+
+        //==============================================================================================================
+        void updateColourMap();
+        void updateRowLookup();
+        void redrawHistory();
+        void drawFrame(const juce::uint8* frame);
+        void drawImage(juce::Graphics& g) const;
+
+        //==============================================================================================================
+        const SpectrogramEngine& engine;
+
+        Canvas background;
+        Canvas spectrogram;
+
+        juce::Image image;
+        int nextColumn{ 0 };
+
+        std::array<juce::PixelARGB, 256> colourMap;
+        juce::NormalisableRange<float> colourMapDecibelRange;
+        bool isColourMapBuilt{ false };
+        std::vector<int> rowForPixel;
+        int rowLookupNumRows{ 0 };
+
+        LookAndFeelAccessor<LookAndFeelMethods> lookAndFeel;
+
+        //==============================================================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Spectrogram)
+    };
+} // namespace jump
@@ -0,0 +1,208 @@
+#include "jump_SpectrogramEngine.h"
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    void SpectrogramEngine::initialise()
+    {
+        {
+            const auto transaction = createTransaction();
+
+            setProperty(PropertyIDs::numRowsId, 512);
+            setProperty(PropertyIDs::numFramesId, 1024);
+        }
+
+        source.addRenderer(this);
+    }
+
+    //==================================================================================================================
+    SpectrogramEngine::SpectrogramEngine(const SpectrumAnalyserEngine& sourceEngine)
+        : source{ sourceEngine }
+    {
+        initialise();
+    }
+
+    SpectrogramEngine::SpectrogramEngine(const SpectrumAnalyserEngine& sourceEngine, const juce::Identifier& uniqueID,
+                                         StatefulObject* parentState)
+        : StatefulObject{ uniqueID, parentState }
+        , source{ sourceEngine }
+    {
+        initialise();
+    }
+
+    SpectrogramEngine::~SpectrogramEngine()
+    {
+        source.removeRenderer(this);
+    }
+
+    //==================================================================================================================
+    void SpectrogramEngine::addRenderer(SpectrogramRendererBase* rendererToAdd) const
+    {
+        renderers.add(rendererToAdd);
+    }
+
+    void SpectrogramEngine::removeRenderer(SpectrogramRendererBase* rendererToRemove) const
+    {
+        renderers.remove(rendererToRemove);
+    }
+
+    //==================================================================================================================
+    void SpectrogramEngine::setNumRows(int newNumRows)
+    {
+        jassert(newNumRows > 0);
+
+        setProperty(PropertyIDs::numRowsId, newNumRows);
+    }
+
+    int SpectrogramEngine::getNumRows() const noexcept
+    {
+        return numRows;
+    }
+
+    void SpectrogramEngine::setNumFrames(int newNumFrames)
+    {
+        jassert(newNumFrames > 0);
+
+        setProperty(PropertyIDs::numFramesId, newNumFrames);
+    }
+
+    int SpectrogramEngine::getNumFrames() const noexcept
+    {
+        return numFrames;
+    }
+
+    int SpectrogramEngine::getNumFramesAvailable() const noexcept
+    {
+        // The frames don't match the number of rows and frames again until the history's been resized.
+        if (isHistoryResizePending)
+            return 0;
+
+        return numFramesAvailable;
+    }
+
+    const juce::uint8* SpectrogramEngine::getFrame(int age) const noexcept
+    {
+        jassert(age >= 0 && age < numFramesAvailable);
+
+        const auto index = (newestFrame - age + numFrames) % numFrames;
+        return frames.data() + static_cast<std::size_t>(index) * static_cast<std::size_t>(numRows);
+    }
+
+    const SpectrumAnalyserEngine& SpectrogramEngine::getSourceEngine() const noexcept
+    {
+        return source;
+    }
+
+    //==================================================================================================================
+    void SpectrogramEngine::newSpectrumAnalyserPointsAvailable(const SpectrumAnalyserEngine&,
+                                                               const std::vector<juce::Point<float>>& points)
+    {
+        if (frames.empty() || isHistoryResizePending)
+            return;
+
+        newestFrame = (newestFrame + 1) % numFrames;
+        numFramesAvailable = juce::jmin(numFramesAvailable + 1, numFrames);
+
+        auto* frame = frames.data() + static_cast<std::size_t>(newestFrame) * static_cast<std::size_t>(numRows);
+
+        if (points.empty())
+        {
+            std::fill_n(frame, numRows, juce::uint8{ 0 });
+        }
+        else
+        {
+            // The points are sorted by frequency so each row only needs to look from where the previous row left off.
+            std::size_t nextPoint = 0;
+
+            for (auto row = 0; row < numRows; row++)
+            {
+                const auto x = (static_cast<float>(row) + 0.5f) / static_cast<float>(numRows);
+
+                while (nextPoint < points.size() && points[nextPoint].x < x)
+                    nextPoint++;
+
+                auto y = 0.f;
+
+                if (nextPoint == 0)
+                    y = points.front().y;
+                else if (nextPoint == points.size())
+                    y = points.back().y;
+                else
+                {
+                    const auto& previous = points[nextPoint - 1];
+                    const auto& next = points[nextPoint];
+                    y = juce::jmap(x, previous.x, next.x, previous.y, next.y);
+                }
+
+                // The points' Y values are measured down from the top of the Decibel range.
+                frame[row] = static_cast<juce::uint8>(juce::roundToInt(juce::jlimit(0.f, 1.f, 1.f - y) * 255.f));
+            }
+        }
+
+        renderers.call(&SpectrogramRendererBase::newSpectrogramFrameAvailable, *this);
+    }
+
+    bool SpectrogramEngine::isRendererVisible() const
+    {
+        auto isVisible = false;
+
+        renderers.call([&isVisible](SpectrogramRendererBase& renderer) {
+            isVisible = isVisible || renderer.isRendererVisible();
+        });
+
+        return isVisible;
+    }
+
+    bool SpectrogramEngine::needsContinuousUpdates() const
+    {
+        // Each update adds a column to the history, so it has to keep scrolling even while the spectrum isn't changing.
+        return true;
+    }
+
+    void SpectrogramEngine::propertyChanged(const juce::Identifier& name, const juce::var& newValue)
+    {
+        if (name == PropertyIDs::numRowsId)
+        {
+            numRows = newValue;
+            resizeHistory();
+        }
+        else if (name == PropertyIDs::numFramesId)
+        {
+            numFrames = newValue;
+            resizeHistory();
+        }
+        else
+        {
+            // Unhandled property ID.
+            jassertfalse;
+        }
+    }
+
+    void SpectrogramEngine::transactionCommitted()
+    {
+        if (std::exchange(isHistoryResizePending, false))
+            resizeHistory();
+    }
+
+    //==================================================================================================================
+    void SpectrogramEngine::resizeHistory()
+    {
+        if (isInTransaction())
+        {
+            isHistoryResizePending = true;
+            return;
+        }
+
+        newestFrame = 0;
+        numFramesAvailable = 0;
+
+        if (numRows <= 0 || numFrames <= 0)
+        {
+            frames.clear();
+            return;
+        }
+
+        frames.assign(static_cast<std::size_t>(numRows) * static_cast<std::size_t>(numFrames), juce::uint8{ 0 });
+    }
+} // namespace jump
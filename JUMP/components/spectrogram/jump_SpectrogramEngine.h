@@ -0,0 +1,163 @@
+#pragma once
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    class SpectrogramEngine;
+
+    //==================================================================================================================
+    struct SpectrogramRendererBase
+    {
+        //==============================================================================================================
+        virtual ~SpectrogramRendererBase() = default;
+
+        //==============================================================================================================
+        /** Derived classes must override this method in order to receive callbacks when the given engine has added a
+            new frame to its history.
+
+            The new frame can be accessed with SpectrogramEngine::getFrame(0).
+        */
+        virtual void newSpectrogramFrameAvailable(const SpectrogramEngine& engine) = 0;
+
+        /** Derived classes can override this method to tell the engine whether they're currently visible to the user.
+
+            A spectrogram engine whose renderers are all hidden counts as a hidden renderer of its source engine, which
+            is then among the first to be slowed down when the EngineScheduler runs over budget. Renderers are assumed
+            to be visible by default.
+        */
+        virtual bool isRendererVisible() const
+        {
+            return true;
+        }
+    };
+
+    //==================================================================================================================
+    /** Keeps a history of the spectra calculated by a SpectrumAnalyserEngine so they can be drawn as a spectrogram.
+
+        Each time the spectrum engine calculates a new set of points, they're resampled into a frame of evenly spaced
+        rows on the same logarithmic frequency scale, and each row's normalised level is quantised to 8 bits so a
+        renderer can map the rows straight to colours with a 256-entry lookup table. The frames are kept in a ring that's
+        allocated up-front so adding a frame never allocates. Since the rows come from the points rather than the FFT
+        bins, the spectrogram's vertical resolution is limited by the spectrum engine's number of points.
+
+        All of the spectrum engine's settings (the FFT size, frequency and Decibel ranges, averaging, execution mode,
+        and so on) apply to the spectrogram as well. That includes its peak hold and decay, so short hold and decay times
+        give the sharpest spectrogram.
+    */
+    class SpectrogramEngine
+        : public SpectrumAnalyserRendererBase
+        , protected StatefulObject
+    {
+    public:
+        //==============================================================================================================
+        struct PropertyIDs
+        {
+            static const inline juce::Identifier numRowsId{ "numRows" };
+            static const inline juce::Identifier numFramesId{ "numFrames" };
+        };
+
+        //==============================================================================================================
+        explicit SpectrogramEngine(const SpectrumAnalyserEngine& sourceEngine);
+        SpectrogramEngine(const SpectrumAnalyserEngine& sourceEngine, const juce::Identifier& uniqueID,
+                          StatefulObject* parentState);
+        ~SpectrogramEngine() override;
+
+        //==============================================================================================================
+        /** Opens a transaction so the number of rows and frames can both be changed while only resizing the history
+            once.
+
+            @see StatefulObject::ScopedTransaction
+        */
+        using StatefulObject::createTransaction;
+
+        //==============================================================================================================
+        /** Registers a renderer that will receive callbacks when new frames are added by this engine.
+
+            @param rendererToAdd    The renderer to add.
+        */
+        void addRenderer(SpectrogramRendererBase* rendererToAdd) const;
+
+        /** Removes a renderer from this engine so that it will no longer receive callbacks.
+
+            @param rendererToRemove The renderer that should be removed.
+        */
+        void removeRenderer(SpectrogramRendererBase* rendererToRemove) const;
+
+        //==============================================================================================================
+        /** Changes the number of rows each frame is resampled to.
+
+            The rows are evenly spaced over the spectrum engine's frequency range on a logarithmic scale, the same as
+            the points it calculates. Changing this clears the history.
+
+            Each row is interpolated from the spectrum engine's points rather than from its FFT bins, so the rows can't
+            resolve any more detail than the points do. For the full vertical resolution, give the spectrum engine at
+            least as many points as there are rows (see SpectrumAnalyserEngine::setNumPoints(), which defaults to 256).
+
+            The default is 512.
+
+            @param newNumRows   The new number of rows to use.
+        */
+        void setNumRows(int newNumRows);
+
+        /** Returns the number of rows in each frame. */
+        int getNumRows() const noexcept;
+
+        /** Changes the number of frames kept in the history.
+
+            Changing this clears the history.
+
+            The default is 1024.
+
+            @param newNumFrames The new number of frames to keep.
+        */
+        void setNumFrames(int newNumFrames);
+
+        /** Returns the maximum number of frames kept in the history. */
+        int getNumFrames() const noexcept;
+
+        /** Returns the number of frames currently in the history. */
+        int getNumFramesAvailable() const noexcept;
+
+        /** Returns one of the frames in the history.
+
+            Each frame holds getNumRows() levels, from the lowest frequency to the highest, where 0 is the bottom of
+            the spectrum engine's Decibel range and 255 is the top. The pointer is valid until the history is resized.
+
+            @param age  How many frames ago the frame was added, where 0 is the newest frame. This must be less than
+                        getNumFramesAvailable().
+        */
+        const juce::uint8* getFrame(int age) const noexcept;
+
+        /** Returns the engine whose spectra this engine keeps the history of. */
+        const SpectrumAnalyserEngine& getSourceEngine() const noexcept;
+
+    private:
+        //==============================================================================================================
+        void newSpectrumAnalyserPointsAvailable(const SpectrumAnalyserEngine& engine,
+                                                const std::vector<juce::Point<float>>& points) override;
+        bool isRendererVisible() const override;
+        bool needsContinuousUpdates() const override;
+        void propertyChanged(const juce::Identifier& name, const juce::var& newValue) override;
+        void transactionCommitted() override;
+
+        //==============================================================================================================
+        void initialise();
+        void resizeHistory();
+
+        //==============================================================================================================
+        const SpectrumAnalyserEngine& source;
+
+        std::vector<juce::uint8> frames;
+        int numRows{ 0 };
+        int numFrames{ 0 };
+        int newestFrame{ 0 };
+        int numFramesAvailable{ 0 };
+        bool isHistoryResizePending{ false };
+
+        mutable juce::ListenerList<SpectrogramRendererBase> renderers;
+
+        //==============================================================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrogramEngine)
+    };
+} // namespace jump
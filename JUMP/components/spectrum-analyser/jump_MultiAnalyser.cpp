@@ -32,6 +32,12 @@ namespace jump
         addAndMakeVisible(labels);
     }
 
+    MultiAnalyser::MultiAnalyser(const MultichannelSpectrumAnalyserEngine& multichannelEngine,
+                                 juce::Identifier type, StatefulObject* parentState)
+        : MultiAnalyser{ multichannelEngine.getEngines(), type, parentState }
+    {
+    }
+
     //==================================================================================================================
     void MultiAnalyser::setShowLabels(bool shouldShowLabels)
     {
@@ -20,6 +20,11 @@ namespace jump
                       juce::Identifier type = "NonStatefulMultiAnalyser",
                       StatefulObject* parentState = nullptr);
 
+        /** Creates an analyser for each channel (and any derived spectrum) of the given engine. */
+        MultiAnalyser(const MultichannelSpectrumAnalyserEngine& multichannelEngine,
+                      juce::Identifier type = "NonStatefulMultiAnalyser",
+                      StatefulObject* parentState = nullptr);
+
         //==============================================================================================================
         void setShowLabels(bool shouldShowLabels);
         void setHighlightedLevels(const std::vector<float>& newLevels);
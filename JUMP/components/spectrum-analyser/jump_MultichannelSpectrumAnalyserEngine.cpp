@@ -0,0 +1,444 @@
+#include "jump_MultichannelSpectrumAnalyserEngine.h"
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    void MultichannelSpectrumAnalyserEngine::initialise(int numChannels)
+    {
+        jassert(numChannels > 0);
+
+        numInputChannels = numChannels;
+
+        for (auto channel = 0; channel < numChannels; channel++)
+            engines.add(new SpectrumAnalyserEngine{ "Channel" + juce::String{ channel }, this });
+
+        if (derivedSpectra == DerivedSpectra::midSide)
+        {
+            engines.add(new SpectrumAnalyserEngine{ "Mid", this });
+            engines.add(new SpectrumAnalyserEngine{ "Side", this });
+        }
+        else if (derivedSpectra == DerivedSpectra::sum)
+        {
+            engines.add(new SpectrumAnalyserEngine{ "Sum", this });
+        }
+
+        // This engine updates all of the channels' engines at once, so they shouldn't update themselves.
+        for (auto* engine : engines)
+            engine->setFPS(0);
+
+        updateWorkspaces(engines[0]->fft->getSize());
+        scheduler->addClient(*this, fps, priority);
+    }
+
+    static MultichannelSpectrumAnalyserEngine::DerivedSpectra
+        getSupportedDerivedSpectra(int numChannels, MultichannelSpectrumAnalyserEngine::DerivedSpectra derivedSpectra)
+    {
+        using DerivedSpectra = MultichannelSpectrumAnalyserEngine::DerivedSpectra;
+
+        // Mid/side spectra are only meaningful for a stereo pair, so with any other number of channels they're dropped
+        // rather than derived from the wrong channels.
+        if (derivedSpectra == DerivedSpectra::midSide && numChannels != 2)
+        {
+            jassertfalse;
+            return DerivedSpectra::none;
+        }
+
+        return derivedSpectra;
+    }
+
+    //==================================================================================================================
+    MultichannelSpectrumAnalyserEngine::MultichannelSpectrumAnalyserEngine(int numChannels,
+                                                                           DerivedSpectra derivedSpectraToUse)
+        : derivedSpectra{ getSupportedDerivedSpectra(numChannels, derivedSpectraToUse) }
+    {
+        initialise(numChannels);
+    }
+
+    MultichannelSpectrumAnalyserEngine::MultichannelSpectrumAnalyserEngine(int numChannels,
+                                                                           DerivedSpectra derivedSpectraToUse,
+                                                                           const juce::Identifier& uniqueID,
+                                                                           StatefulObject* parentState)
+        : StatefulObject{ uniqueID, parentState }
+        , derivedSpectra{ getSupportedDerivedSpectra(numChannels, derivedSpectraToUse) }
+    {
+        initialise(numChannels);
+    }
+
+    MultichannelSpectrumAnalyserEngine::~MultichannelSpectrumAnalyserEngine()
+    {
+        scheduler->removeClient(*this);
+    }
+
+    //==================================================================================================================
+    void MultichannelSpectrumAnalyserEngine::addSamples(const juce::dsp::AudioBlock<const float>& block)
+    {
+        const auto numChannels = juce::jmin(numInputChannels, static_cast<int>(block.getNumChannels()));
+
+        for (auto channel = 0; channel < numChannels; channel++)
+        {
+            engines[channel]->addSamples(block.getChannelPointer(static_cast<std::size_t>(channel)),
+                                         static_cast<int>(block.getNumSamples()));
+        }
+    }
+
+    int MultichannelSpectrumAnalyserEngine::getNumChannels() const noexcept
+    {
+        return numInputChannels;
+    }
+
+    std::vector<SpectrumAnalyserEngine*> MultichannelSpectrumAnalyserEngine::getEngines() const
+    {
+        std::vector<SpectrumAnalyserEngine*> result;
+        result.reserve(static_cast<std::size_t>(engines.size()));
+
+        for (auto* engine : engines)
+            result.push_back(engine);
+
+        return result;
+    }
+
+    //==================================================================================================================
+    void MultichannelSpectrumAnalyserEngine::setFPS(int newFPS)
+    {
+        fps = juce::jmax(newFPS, 0);
+        scheduler->addClient(*this, fps, priority);
+    }
+
+    void MultichannelSpectrumAnalyserEngine::setUpdatePriority(EngineScheduler::Priority newPriority)
+    {
+        priority = newPriority;
+        scheduler->setPriority(*this, priority);
+    }
+
+    bool MultichannelSpectrumAnalyserEngine::hasVisibleRenderers() const
+    {
+        for (const auto* engine : engines)
+        {
+            if (engine->hasVisibleRenderers())
+                return true;
+        }
+
+        return false;
+    }
+
+    //==================================================================================================================
+    void MultichannelSpectrumAnalyserEngine::setSampleRate(double newSampleRate)
+    {
+        jassert(newSampleRate > 0.0);
+
+        setProperty(SharedPropertyIDs::sampleRateId, newSampleRate);
+    }
+
+    void MultichannelSpectrumAnalyserEngine::setWindowingMethod(
+        SpectrumAnalyserEngine::WindowingMethod newWindowingMethod)
+    {
+        setProperty(SpectrumAnalyserEngine::PropertyIDs::windowingMethodId,
+                    var_cast<SpectrumAnalyserEngine::WindowingMethod>(newWindowingMethod));
+    }
+
+    void MultichannelSpectrumAnalyserEngine::setFFTOrder(int newFFTOrder)
+    {
+        jassert(newFFTOrder >= 0);
+
+        setProperty(SpectrumAnalyserEngine::PropertyIDs::fftOrderId, newFFTOrder);
+    }
+
+    void MultichannelSpectrumAnalyserEngine::setWindowLength(int newWindowLength)
+    {
+        jassert(newWindowLength >= 0);
+
+        setProperty(SpectrumAnalyserEngine::PropertyIDs::windowLengthId, newWindowLength);
+    }
+
+    void MultichannelSpectrumAnalyserEngine::setFrequencyRange(const juce::NormalisableRange<float>& newFrequencyRange)
+    {
+        jassert(newFrequencyRange.start > 0.f);
+
+        setProperty(SpectrumAnalyserEngine::PropertyIDs::frequencyRangeId,
+                    var_cast<juce::NormalisableRange<float>>(newFrequencyRange));
+    }
+
+    void MultichannelSpectrumAnalyserEngine::setDecibelRange(const juce::NormalisableRange<float>& newDecibelRange)
+    {
+        setProperty(SpectrumAnalyserEngine::PropertyIDs::decibelRangeId,
+                    var_cast<juce::NormalisableRange<float>>(newDecibelRange));
+    }
+
+    void MultichannelSpectrumAnalyserEngine::setHoldTime(float newHoldTimeMs)
+    {
+        jassert(newHoldTimeMs >= 0.f);
+
+        setProperty(SpectrumAnalyserEngine::PropertyIDs::holdTimeId, newHoldTimeMs);
+    }
+
+    void MultichannelSpectrumAnalyserEngine::setMaxHoldTime(float newMaxHoldTimeMs)
+    {
+        jassert(newMaxHoldTimeMs >= 0.f);
+
+        setProperty(SpectrumAnalyserEngine::PropertyIDs::maxHoldTimeId, newMaxHoldTimeMs);
+    }
+
+    void MultichannelSpectrumAnalyserEngine::setDecayTime(float newDecayTimeMs)
+    {
+        jassert(newDecayTimeMs >= 0.f);
+
+        setProperty(SpectrumAnalyserEngine::PropertyIDs::decayTimeId, newDecayTimeMs);
+    }
+
+    void MultichannelSpectrumAnalyserEngine::setNumPoints(int newNumPoints)
+    {
+        jassert(newNumPoints >= 0);
+
+        setProperty(SpectrumAnalyserEngine::PropertyIDs::numPointsId, newNumPoints);
+    }
+
+    void MultichannelSpectrumAnalyserEngine::setOverlap(float newOverlap)
+    {
+        jassert(newOverlap >= 0.f && newOverlap < 1.f);
+
+        setProperty(SpectrumAnalyserEngine::PropertyIDs::overlapId, newOverlap);
+    }
+
+    void MultichannelSpectrumAnalyserEngine::setAveragingMode(SpectrumAnalyserEngine::AveragingMode newAveragingMode)
+    {
+        setProperty(SpectrumAnalyserEngine::PropertyIDs::averagingModeId,
+                    var_cast<SpectrumAnalyserEngine::AveragingMode>(newAveragingMode));
+    }
+
+    void MultichannelSpectrumAnalyserEngine::setAveragingTime(float newAveragingTimeMs)
+    {
+        jassert(newAveragingTimeMs > 0.f);
+
+        setProperty(SpectrumAnalyserEngine::PropertyIDs::averagingTimeId, newAveragingTimeMs);
+    }
+
+    void MultichannelSpectrumAnalyserEngine::setMaxFramesPerUpdate(int newMaxFramesPerUpdate)
+    {
+        jassert(newMaxFramesPerUpdate > 0);
+
+        setProperty(SpectrumAnalyserEngine::PropertyIDs::maxFramesPerUpdateId, newMaxFramesPerUpdate);
+    }
+
+    void MultichannelSpectrumAnalyserEngine::setBinAggregation(
+        SpectrumAnalyserEngine::BinAggregation newBinAggregation)
+    {
+        setProperty(SpectrumAnalyserEngine::PropertyIDs::binAggregationId,
+                    var_cast<SpectrumAnalyserEngine::BinAggregation>(newBinAggregation));
+    }
+
+    void MultichannelSpectrumAnalyserEngine::setNumResolutionBands(int newNumResolutionBands)
+    {
+        jassert(newNumResolutionBands > 0);
+
+        setProperty(SpectrumAnalyserEngine::PropertyIDs::numResolutionBandsId, newNumResolutionBands);
+    }
+
+    void MultichannelSpectrumAnalyserEngine::setSmoothing(SpectrumAnalyserEngine::Smoothing newSmoothing)
+    {
+        setProperty(SpectrumAnalyserEngine::PropertyIDs::smoothingId,
+                    var_cast<SpectrumAnalyserEngine::Smoothing>(newSmoothing));
+    }
+
+    //==================================================================================================================
+    void MultichannelSpectrumAnalyserEngine::scheduledUpdate(juce::uint32 now)
+    {
+        const auto& reference = *engines[0];
+
+        // The workspaces are sized with the FFT, so they can only be out of step part-way through a change of order
+        // or a transaction.
+        if (reference.fft.get() == nullptr || static_cast<int>(packedFrame.size()) != reference.fft->getSize()
+            || reference.hasPendingUpdates())
+            return;
+
+        auto idle = true;
+        auto hasNewSamples = false;
+
+        for (auto i = 0; i < engines.size(); i++)
+        {
+            idle = idle && engines[i]->isIdle();
+
+            // The derived engines never receive samples of their own, so it's only the channels' engines that say
+            // whether there's anything new to transform.
+            if (i < numInputChannels)
+                hasNewSamples = hasNewSamples || engines[i]->hasNewSamples;
+        }
+
+        for (auto* engine : engines)
+            engine->hasNewSamples = false;
+
+        if (idle)
+        {
+            for (auto* engine : engines)
+                engine->notifyContinuousRenderers(engine->points);
+
+            return;
+        }
+
+        if (hasNewSamples)
+        {
+            for (auto band = 0; band < reference.bands.size(); band++)
+                updateBand(band);
+        }
+
+        for (auto* engine : engines)
+            engine->publishPointsFromSpectra(now);
+    }
+
+    void MultichannelSpectrumAnalyserEngine::propertyChanged(const juce::Identifier& name, const juce::var& newValue)
+    {
+        // Every property is passed on to the channels' engines, so only the ones that affect this engine's workspaces
+        // need handling here.
+        if (name == SpectrumAnalyserEngine::PropertyIDs::fftOrderId)
+            updateWorkspaces(1 << static_cast<int>(newValue));
+    }
+
+    //==================================================================================================================
+    void MultichannelSpectrumAnalyserEngine::updateWorkspaces(int fftSize)
+    {
+        const auto size = static_cast<std::size_t>(fftSize);
+        numBins = size / 2 + 1;
+
+        packedFrame.assign(size, {});
+        transformedFrame.assign(size, {});
+        channelSpectra.assign(static_cast<std::size_t>(numInputChannels) * numBins, {});
+        derivedSpectrum.assign(derivedSpectra == DerivedSpectra::sum ? numBins : 0, {});
+        magnitudes.assign(numBins, 0.f);
+    }
+
+    void MultichannelSpectrumAnalyserEngine::updateBand(int band)
+    {
+        const auto& reference = *engines[0];
+
+        // The derived spectra have no samples of their own, so they follow the inputs' framing.
+        for (auto i = numInputChannels; i < engines.size(); i++)
+            engines[i]->bands[band]->numPendingSamples = reference.bands[band]->numPendingSamples;
+
+        // Every engine has the same settings and is sent the same number of samples, so they agree on the frames.
+        auto numFrames = 0;
+
+        for (auto* engine : engines)
+            numFrames = engine->beginSpectrumUpdate(*engine->bands[band]);
+
+        const auto bandSampleRate = reference.getBandSampleRate(band);
+
+        // Oldest frame first so the exponential average ends on the newest frame.
+        for (auto frame = numFrames - 1; frame >= 0; frame--)
+        {
+            transformChannels(band, frame);
+            addChannelSpectra(band, numFrames, bandSampleRate);
+            addDerivedSpectra(band, numFrames, bandSampleRate);
+        }
+
+        if (numFrames == 0)
+            return;
+
+        for (auto* engine : engines)
+            engine->finishSpectrumUpdate(*engine->bands[band]);
+    }
+
+    void MultichannelSpectrumAnalyserEngine::transformChannels(int band, int frame)
+    {
+        const auto& reference = *engines[0];
+        const auto& window = *reference.windowingTable;
+        const auto fftSize = packedFrame.size();
+
+        // Since each channel is real, two channels can be transformed at once as the real and imaginary parts of a
+        // complex signal, using the conjugate symmetry of their spectra to separate them again afterwards.
+        for (auto first = 0; first < numInputChannels; first += 2)
+        {
+            const auto second = first + 1;
+            const auto hasSecond = second < numInputChannels;
+
+            const auto* firstSamples = engines[first]->getFrameSamples(*engines[first]->bands[band], frame);
+            const auto* secondSamples = hasSecond
+                                          ? engines[second]->getFrameSamples(*engines[second]->bands[band], frame)
+                                          : nullptr;
+
+            for (std::size_t i = 0; i < window.size(); i++)
+            {
+                packedFrame[i] = { firstSamples[i] * window[i],
+                                   hasSecond ? secondSamples[i] * window[i] : 0.f };
+            }
+
+            std::fill(packedFrame.begin() + static_cast<std::ptrdiff_t>(window.size()), packedFrame.end(), Complex{});
+
+            reference.fft->perform(packedFrame.data(), transformedFrame.data(), false);
+
+            auto* firstSpectrum = getChannelSpectrum(first);
+            auto* secondSpectrum = hasSecond ? getChannelSpectrum(second) : nullptr;
+
+            for (std::size_t bin = 0; bin < numBins; bin++)
+            {
+                const auto packed = transformedFrame[bin];
+                const auto mirrored = std::conj(transformedFrame[(fftSize - bin) % fftSize]);
+
+                firstSpectrum[bin] = (packed + mirrored) * 0.5f;
+
+                if (hasSecond)
+                    secondSpectrum[bin] = (packed - mirrored) * Complex{ 0.f, -0.5f };
+            }
+        }
+    }
+
+    static void magnitudesInto(std::vector<float>& destination, const juce::dsp::Complex<float>* spectrum)
+    {
+        std::transform(spectrum, spectrum + destination.size(), destination.begin(),
+                       [](const juce::dsp::Complex<float>& bin) {
+                           return std::abs(bin);
+                       });
+    }
+
+    void MultichannelSpectrumAnalyserEngine::addChannelSpectra(int band, int numFrames, float bandSampleRate)
+    {
+        for (auto channel = 0; channel < numInputChannels; channel++)
+        {
+            auto& engine = *engines[channel];
+
+            magnitudesInto(magnitudes, getChannelSpectrum(channel));
+            engine.addFrameToSpectrum(*engine.bands[band], magnitudes.data(), numFrames, bandSampleRate);
+        }
+    }
+
+    void MultichannelSpectrumAnalyserEngine::addDerivedSpectra(int band, int numFrames, float bandSampleRate)
+    {
+        if (derivedSpectra == DerivedSpectra::midSide)
+        {
+            const auto* left = getChannelSpectrum(0);
+            const auto* right = getChannelSpectrum(1);
+
+            for (std::size_t bin = 0; bin < numBins; bin++)
+                magnitudes[bin] = std::abs((left[bin] + right[bin]) * 0.5f);
+
+            engines[2]->addFrameToSpectrum(*engines[2]->bands[band], magnitudes.data(), numFrames, bandSampleRate);
+
+            for (std::size_t bin = 0; bin < numBins; bin++)
+                magnitudes[bin] = std::abs((left[bin] - right[bin]) * 0.5f);
+
+            engines[3]->addFrameToSpectrum(*engines[3]->bands[band], magnitudes.data(), numFrames, bandSampleRate);
+        }
+        else if (derivedSpectra == DerivedSpectra::sum)
+        {
+            std::copy_n(getChannelSpectrum(0), numBins, derivedSpectrum.begin());
+
+            for (auto channel = 1; channel < numInputChannels; channel++)
+            {
+                const auto* spectrum = getChannelSpectrum(channel);
+
+                for (std::size_t bin = 0; bin < numBins; bin++)
+                    derivedSpectrum[bin] += spectrum[bin];
+            }
+
+            magnitudesInto(magnitudes, derivedSpectrum.data());
+
+            auto& engine = *engines[numInputChannels];
+            engine.addFrameToSpectrum(*engine.bands[band], magnitudes.data(), numFrames, bandSampleRate);
+        }
+    }
+
+    MultichannelSpectrumAnalyserEngine::Complex*
+        MultichannelSpectrumAnalyserEngine::getChannelSpectrum(int channel) noexcept
+    {
+        return channelSpectra.data() + static_cast<std::size_t>(channel) * numBins;
+    }
+} // namespace jump
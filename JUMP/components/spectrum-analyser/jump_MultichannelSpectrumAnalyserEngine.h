@@ -0,0 +1,185 @@
+#pragma once
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    /** Analyses several channels of audio at once, producing a SpectrumAnalyserEngine's worth of points for each.
+
+        Rather than each channel's engine being scheduled and transforming its own samples separately, this engine
+        updates all of them in a single pass, sharing the first channel's FFT and windowing table. Channels are
+        transformed in pairs, one as the real part and the other as the imaginary part of a single complex FFT, which is
+        then unpacked into each channel's complex spectrum - so an 8-channel analyser costs 4 FFTs per frame rather
+        than 8. Each channel's spectrum is kept contiguous and worked through in turn, so the averaging and point
+        calculations run over one block of memory at a time.
+
+        Because the complex spectra are kept, mid/side or sum spectra can be derived from the same transforms without
+        any extra FFTs (see DerivedSpectra).
+
+        Like SpectrumAnalyserEngine, nothing is transformed while no new samples are arriving, and nothing is updated at
+        all once every engine's points have settled.
+
+        The per-channel engines, which are what SpectrumAnalyser components draw, are available through getEngines().
+        All of them share the settings made through this engine - they shouldn't be configured individually, and
+        analysis always happens on the message thread.
+    */
+    class MultichannelSpectrumAnalyserEngine
+        : protected StatefulObject
+        , private EngineScheduler::Client
+    {
+    public:
+        //==============================================================================================================
+        /** Additional spectra that can be derived from the channels' transforms. */
+        enum class DerivedSpectra
+        {
+            /** No additional spectra. */
+            none,
+
+            /** The spectra of the mid (L + R) / 2 and side (L - R) / 2 signals of a stereo pair. Only valid with exactly
+                2 channels - with any other number, no derived spectra are calculated.
+            */
+            midSide,
+
+            /** The spectrum of the sum of all the channels. */
+            sum
+        };
+
+        //==============================================================================================================
+        explicit MultichannelSpectrumAnalyserEngine(int numChannels,
+                                                    DerivedSpectra derivedSpectraToUse = DerivedSpectra::none);
+        MultichannelSpectrumAnalyserEngine(int numChannels, DerivedSpectra derivedSpectraToUse,
+                                           const juce::Identifier& uniqueID, StatefulObject* parentState);
+        ~MultichannelSpectrumAnalyserEngine() override;
+
+        //==============================================================================================================
+        /** Opens a transaction covering every channel's engine.
+
+            @see StatefulObject::ScopedTransaction
+        */
+        using StatefulObject::createTransaction;
+
+        //==============================================================================================================
+        /** Writes a block of samples to the channels' sample buffers.
+
+            This pairs with the visitor-based read() method of MultichannelAudioTransferManager. Any channels in the
+            block beyond the number this engine was created with are ignored.
+
+            @param block    The samples to write, with one channel per channel of this engine.
+        */
+        void addSamples(const juce::dsp::AudioBlock<const float>& block);
+
+        /** Returns the number of input channels this engine was created with. */
+        int getNumChannels() const noexcept;
+
+        /** Returns the engines holding the points of each channel, followed by those of any derived spectra (mid then
+            side, or the sum).
+
+            The engines can be drawn by SpectrumAnalyser components, e.g. through a MultiAnalyser.
+        */
+        std::vector<SpectrumAnalyserEngine*> getEngines() const;
+
+        //==============================================================================================================
+        /** Changes the rate at which the channels are analysed and their points calculated.
+
+            @see AudioComponentEngine::setFPS()
+        */
+        void setFPS(int newFPS);
+
+        /** @see AudioComponentEngine::setUpdatePriority() */
+        void setUpdatePriority(EngineScheduler::Priority newPriority);
+
+        /** Returns true if any of the engines' renderers are currently visible. */
+        bool hasVisibleRenderers() const override;
+
+        //==============================================================================================================
+        /** @see SpectrumAnalyserEngine::setSampleRate() */
+        void setSampleRate(double newSampleRate);
+
+        /** @see SpectrumAnalyserEngine::setWindowingMethod() */
+        void setWindowingMethod(SpectrumAnalyserEngine::WindowingMethod newWindowingMethod);
+
+        /** @see SpectrumAnalyserEngine::setFFTOrder() */
+        void setFFTOrder(int newFFTOrder);
+
+        /** @see SpectrumAnalyserEngine::setWindowLength() */
+        void setWindowLength(int newWindowLength);
+
+        /** @see SpectrumAnalyserEngine::setFrequencyRange() */
+        void setFrequencyRange(const juce::NormalisableRange<float>& newFrequencyRange);
+
+        /** @see SpectrumAnalyserEngine::setDecibelRange() */
+        void setDecibelRange(const juce::NormalisableRange<float>& newDecibelRange);
+
+        /** @see SpectrumAnalyserEngine::setHoldTime() */
+        void setHoldTime(float newHoldTimeMs);
+
+        /** @see SpectrumAnalyserEngine::setMaxHoldTime() */
+        void setMaxHoldTime(float newMaxHoldTimeMs);
+
+        /** @see SpectrumAnalyserEngine::setDecayTime() */
+        void setDecayTime(float newDecayTimeMs);
+
+        /** @see SpectrumAnalyserEngine::setNumPoints() */
+        void setNumPoints(int newNumPoints);
+
+        /** @see SpectrumAnalyserEngine::setOverlap() */
+        void setOverlap(float newOverlap);
+
+        /** @see SpectrumAnalyserEngine::setAveragingMode() */
+        void setAveragingMode(SpectrumAnalyserEngine::AveragingMode newAveragingMode);
+
+        /** @see SpectrumAnalyserEngine::setAveragingTime() */
+        void setAveragingTime(float newAveragingTimeMs);
+
+        /** @see SpectrumAnalyserEngine::setMaxFramesPerUpdate() */
+        void setMaxFramesPerUpdate(int newMaxFramesPerUpdate);
+
+        /** @see SpectrumAnalyserEngine::setBinAggregation() */
+        void setBinAggregation(SpectrumAnalyserEngine::BinAggregation newBinAggregation);
+
+        /** @see SpectrumAnalyserEngine::setNumResolutionBands() */
+        void setNumResolutionBands(int newNumResolutionBands);
+
+        /** @see SpectrumAnalyserEngine::setSmoothing() */
+        void setSmoothing(SpectrumAnalyserEngine::Smoothing newSmoothing);
+
+    private:
+        //==============================================================================================================
+        friend class MultichannelSpectrumAnalyserEngineTests;
+
+        //==============================================================================================================
+        using Complex = juce::dsp::Complex<float>;
+
+        //==============================================================================================================
+        void scheduledUpdate(juce::uint32 now) override;
+        void propertyChanged(const juce::Identifier& name, const juce::var& newValue) override;
+
+        //==============================================================================================================
+        void initialise(int numChannels);
+        void updateWorkspaces(int fftSize);
+        void updateBand(int band);
+        void transformChannels(int band, int frame);
+        void addChannelSpectra(int band, int numFrames, float bandSampleRate);
+        void addDerivedSpectra(int band, int numFrames, float bandSampleRate);
+        Complex* getChannelSpectrum(int channel) noexcept;
+
+        //==============================================================================================================
+        const DerivedSpectra derivedSpectra;
+        int numInputChannels{ 0 };
+        juce::OwnedArray<SpectrumAnalyserEngine> engines;
+
+        juce::SharedResourcePointer<EngineScheduler> scheduler;
+        int fps{ 60 };
+        EngineScheduler::Priority priority{ EngineScheduler::Priority::normal };
+
+        std::vector<Complex> packedFrame;
+        std::vector<Complex> transformedFrame;
+        std::vector<Complex> channelSpectra;
+        std::vector<Complex> derivedSpectrum;
+        std::vector<float> magnitudes;
+        std::size_t numBins{ 0 };
+
+        //==============================================================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MultichannelSpectrumAnalyserEngine)
+    };
+} // namespace jump
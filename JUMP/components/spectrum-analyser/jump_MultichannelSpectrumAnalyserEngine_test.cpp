@@ -0,0 +1,172 @@
+#if JUCE_UNIT_TESTS
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    class MultichannelSpectrumAnalyserEngineTests : public juce::UnitTest
+    {
+    public:
+        //==============================================================================================================
+        MultichannelSpectrumAnalyserEngineTests()
+            : juce::UnitTest{ "MultichannelSpectrumAnalyserEngine", "Engines" }
+        {
+        }
+
+        //==============================================================================================================
+        void runTest() override
+        {
+            beginTest("Paired transforms match single-channel transforms");
+            {
+                // An odd number of channels so the last channel is transformed without a partner.
+                MultichannelSpectrumAnalyserEngine engine{ 3 };
+                addNoise(engine);
+
+                engine.transformChannels(0, 0);
+
+                for (auto channel = 0; channel < engine.getNumChannels(); channel++)
+                {
+                    const auto& channelEngine = *engine.engines[channel];
+                    const auto expected = transform(engine, channelEngine.getFrameSamples(*channelEngine.bands[0], 0));
+
+                    expectMagnitudesMatch(engine.getChannelSpectrum(channel), expected);
+                }
+            }
+
+            beginTest("Mid/side spectra match the transforms of the mid and side signals");
+            {
+                MultichannelSpectrumAnalyserEngine engine{ 2,
+                                                           MultichannelSpectrumAnalyserEngine::DerivedSpectra::midSide };
+                addNoise(engine);
+
+                engine.transformChannels(0, 0);
+                engine.addDerivedSpectra(0, 1, engine.engines[0]->getBandSampleRate(0));
+
+                const auto windowLength = engine.engines[0]->windowingTable->size();
+                const auto* left = engine.engines[0]->getFrameSamples(*engine.engines[0]->bands[0], 0);
+                const auto* right = engine.engines[1]->getFrameSamples(*engine.engines[1]->bands[0], 0);
+
+                std::vector<float> mid(windowLength);
+                std::vector<float> side(windowLength);
+
+                for (std::size_t i = 0; i < windowLength; i++)
+                {
+                    mid[i] = (left[i] + right[i]) * 0.5f;
+                    side[i] = (left[i] - right[i]) * 0.5f;
+                }
+
+                expectSpectrumMatches(engine.engines[2]->bands[0]->spectrum, transform(engine, mid.data()));
+                expectSpectrumMatches(engine.engines[3]->bands[0]->spectrum, transform(engine, side.data()));
+            }
+
+            beginTest("Spectrograms keep scrolling while the channels idle");
+            {
+                MultichannelSpectrumAnalyserEngine engine{ 2 };
+                engine.setFPS(0);
+                engine.setSampleRate(48000.0);
+                engine.setFFTOrder(10);
+
+                SpectrogramEngine spectrogram{ *engine.getEngines()[1] };
+                spectrogram.setNumFrames(100);
+
+                juce::AudioBuffer<float> silence{ engine.getNumChannels(), 4800 };
+                silence.clear();
+
+                auto now = juce::Time::getMillisecondCounter();
+
+                const auto addSilence = [&](int numUpdates) {
+                    for (auto i = 0; i < numUpdates; i++)
+                    {
+                        engine.addSamples(juce::dsp::AudioBlock<const float>{ silence });
+                        engine.scheduledUpdate(now);
+                        now += 100;
+                    }
+                };
+
+                // Well beyond the default hold and decay times, so every channel settles and idles.
+                addSilence(20);
+                expect(engine.engines[0]->isIdle() && engine.engines[1]->isIdle());
+
+                const auto numFramesWhenIdle = spectrogram.getNumFramesAvailable();
+                addSilence(10);
+
+                expectEquals(spectrogram.getNumFramesAvailable(), numFramesWhenIdle + 10);
+            }
+        }
+
+    private:
+        //==============================================================================================================
+        /** Sets the engine up to analyse a single frame per update and fills each of its channels with noise. */
+        void addNoise(MultichannelSpectrumAnalyserEngine& engine)
+        {
+            // The transforms are driven by the test rather than the scheduler.
+            engine.setFPS(0);
+            engine.setSampleRate(48000.0);
+            engine.setFFTOrder(10);
+            engine.setAveragingMode(SpectrumAnalyserEngine::AveragingMode::none);
+
+            const auto numSamples = 2 * engine.engines[0]->fft->getSize();
+            juce::AudioBuffer<float> buffer{ engine.getNumChannels(), numSamples };
+            auto& random = getRandom();
+
+            for (auto channel = 0; channel < buffer.getNumChannels(); channel++)
+            {
+                for (auto i = 0; i < numSamples; i++)
+                    buffer.setSample(channel, i, random.nextFloat() * 2.f - 1.f);
+            }
+
+            engine.addSamples(juce::dsp::AudioBlock<const float>{ buffer });
+
+            // As updateBand() does before transforming, so the frames end at the newest sample.
+            for (auto* channelEngine : engine.engines)
+                channelEngine->beginSpectrumUpdate(*channelEngine->bands[0]);
+        }
+
+        /** Returns the magnitudes of the spectrum of the given samples, as a single SpectrumAnalyserEngine would
+            calculate them.
+        */
+        static std::vector<float> transform(const MultichannelSpectrumAnalyserEngine& engine, const float* samples)
+        {
+            const auto& reference = *engine.engines[0];
+            const auto& window = *reference.windowingTable;
+
+            std::vector<float> fftData(static_cast<std::size_t>(reference.fft->getSize()) * 2, 0.f);
+
+            for (std::size_t i = 0; i < window.size(); i++)
+                fftData[i] = samples[i] * window[i];
+
+            reference.fft->performFrequencyOnlyForwardTransform(fftData.data());
+            fftData.resize(engine.numBins);
+
+            return fftData;
+        }
+
+        void expectMagnitudesMatch(const juce::dsp::Complex<float>* spectrum, const std::vector<float>& expected)
+        {
+            std::vector<float> magnitudes(expected.size());
+
+            for (std::size_t bin = 0; bin < magnitudes.size(); bin++)
+                magnitudes[bin] = std::abs(spectrum[bin]);
+
+            expectSpectrumMatches(magnitudes, expected);
+        }
+
+        void expectSpectrumMatches(const std::vector<float>& actual, const std::vector<float>& expected)
+        {
+            expectEquals(actual.size(), expected.size());
+
+            // The transforms round differently, so the magnitudes are compared relative to the loudest bin.
+            const auto peak = *std::max_element(expected.begin(), expected.end());
+            auto maxError = 0.f;
+
+            for (std::size_t bin = 0; bin < juce::jmin(actual.size(), expected.size()); bin++)
+                maxError = juce::jmax(maxError, std::abs(actual[bin] - expected[bin]));
+
+            expectLessThan(maxError, peak * 1.0e-4f);
+        }
+    };
+
+    static MultichannelSpectrumAnalyserEngineTests multichannelSpectrumAnalyserEngineTests;
+} // namespace jump
+
+#endif
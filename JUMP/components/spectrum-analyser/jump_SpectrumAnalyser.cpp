@@ -19,7 +19,7 @@ namespace jump
 
         addAndMakeVisible(analyser);
         analyser.setDrawFunction([this](juce::Graphics& g) {
-            lookAndFeel->drawSpectrumAnalyser(g, *this, analyserPoints, paintOptions);
+            lookAndFeel->drawSpectrumAnalyser(g, *this, engine.getLatestPoints(), paintOptions);
         });
 
         engineToUse.addRenderer(this);
@@ -56,12 +56,17 @@ namespace jump
     }
 
     void SpectrumAnalyser::newSpectrumAnalyserPointsAvailable(const SpectrumAnalyserEngine&,
-                                                              const std::vector<juce::Point<float>>& points)
+                                                              const std::vector<juce::Point<float>>&)
     {
-        analyserPoints = points;
+        // The points are drawn straight from the engine so there's nothing to copy here.
         analyser.repaint();
     }
 
+    bool SpectrumAnalyser::isRendererVisible() const
+    {
+        return isShowing();
+    }
+
     void SpectrumAnalyser::propertyChanged(const juce::Identifier& name, const juce::var& newValue)
     {
         if (name == PropertyIDs::isBackgroundVisibleId)
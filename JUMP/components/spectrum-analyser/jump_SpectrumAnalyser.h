@@ -45,6 +45,7 @@ namespace jump
         void resized() override;
         void newSpectrumAnalyserPointsAvailable(const SpectrumAnalyserEngine&,
                                                 const std::vector<juce::Point<float>>& points) override;
+        bool isRendererVisible() const override;
         void propertyChanged(const juce::Identifier& name, const juce::var& newValue) override;
 
         //==============================================================================================================
@@ -62,8 +63,6 @@ namespace jump
 
         PaintOptions paintOptions{ PaintOptions::strokeAndFill };
 
-        std::vector<juce::Point<float>> analyserPoints;
-
         LookAndFeelAccessor<LookAndFeelMethods> lookAndFeel;
     };
 } // namespace jump
@@ -1,19 +1,98 @@
 #include "jump_SpectrumAnalyserEngine.h"
 
+//======================================================================================================================
+namespace juce
+{
+    //==================================================================================================================
+    template <>
+    struct VariantConverter<jump::SpectrumAnalyserEngine::AveragingMode>
+    {
+        //==============================================================================================================
+        static jump::SpectrumAnalyserEngine::AveragingMode fromVar(const juce::var& v)
+        {
+            return static_cast<jump::SpectrumAnalyserEngine::AveragingMode>(static_cast<int>(v));
+        }
+
+        static juce::var toVar(const jump::SpectrumAnalyserEngine::AveragingMode& mode)
+        {
+            return { static_cast<int>(mode) };
+        }
+    };
+
+    //==================================================================================================================
+    template <>
+    struct VariantConverter<jump::SpectrumAnalyserEngine::ExecutionMode>
+    {
+        //==============================================================================================================
+        static jump::SpectrumAnalyserEngine::ExecutionMode fromVar(const juce::var& v)
+        {
+            return static_cast<jump::SpectrumAnalyserEngine::ExecutionMode>(static_cast<int>(v));
+        }
+
+        static juce::var toVar(const jump::SpectrumAnalyserEngine::ExecutionMode& mode)
+        {
+            return { static_cast<int>(mode) };
+        }
+    };
+
+    //==================================================================================================================
+    template <>
+    struct VariantConverter<jump::SpectrumAnalyserEngine::BinAggregation>
+    {
+        //==============================================================================================================
+        static jump::SpectrumAnalyserEngine::BinAggregation fromVar(const juce::var& v)
+        {
+            return static_cast<jump::SpectrumAnalyserEngine::BinAggregation>(static_cast<int>(v));
+        }
+
+        static juce::var toVar(const jump::SpectrumAnalyserEngine::BinAggregation& aggregation)
+        {
+            return { static_cast<int>(aggregation) };
+        }
+    };
+
+    //==================================================================================================================
+    template <>
+    struct VariantConverter<jump::SpectrumAnalyserEngine::Smoothing>
+    {
+        //==============================================================================================================
+        static jump::SpectrumAnalyserEngine::Smoothing fromVar(const juce::var& v)
+        {
+            return static_cast<jump::SpectrumAnalyserEngine::Smoothing>(static_cast<int>(v));
+        }
+
+        static juce::var toVar(const jump::SpectrumAnalyserEngine::Smoothing& smoothing)
+        {
+            return { static_cast<int>(smoothing) };
+        }
+    };
+} // namespace juce
+
 //======================================================================================================================
 namespace jump
 {
     //==================================================================================================================
     void SpectrumAnalyserEngine::initialise()
     {
+        const auto transaction = createTransaction();
+
+        setProperty(PropertyIDs::numResolutionBandsId, 1);
         setProperty(PropertyIDs::windowingMethodId, var_cast<WindowingMethod>(WindowingMethod::hann));
         setProperty(PropertyIDs::fftOrderId, 0);
+        setProperty(PropertyIDs::windowLengthId, 0);
         setProperty(PropertyIDs::frequencyRangeId, var_cast<juce::NormalisableRange<float>>({ 20.f, 20000.f }));
         setProperty(PropertyIDs::decibelRangeId, var_cast<juce::NormalisableRange<float>>({ -100.f, 0.f }));
         setProperty(PropertyIDs::holdTimeId, 100.f);
         setProperty(PropertyIDs::maxHoldTimeId, 10000.f);
         setProperty(PropertyIDs::decayTimeId, 500.f);
         setProperty(PropertyIDs::numPointsId, 256);
+        setProperty(PropertyIDs::overlapId, 0.5f);
+        setProperty(PropertyIDs::averagingModeId, var_cast<AveragingMode>(AveragingMode::none));
+        setProperty(PropertyIDs::averagingTimeId, 100.f);
+        setProperty(PropertyIDs::maxFramesPerUpdateId, 8);
+        setProperty(PropertyIDs::executionModeId, var_cast<ExecutionMode>(ExecutionMode::messageThread));
+        setProperty(PropertyIDs::binAggregationId, var_cast<BinAggregation>(BinAggregation::max));
+        setProperty(PropertyIDs::smoothingId, var_cast<Smoothing>(Smoothing::none));
     }
 
     //==================================================================================================================
@@ -28,11 +107,70 @@ namespace jump
         initialise();
     }
 
+    SpectrumAnalyserEngine::~SpectrumAnalyserEngine()
+    {
+        // Make sure the background thread is done with this engine before any of it is destroyed.
+        setExecutionModeInternal(ExecutionMode::messageThread);
+    }
+
     //==================================================================================================================
-    void SpectrumAnalyserEngine::addSamples(const std::vector<float>& samples)
+    void SpectrumAnalyserEngine::addSamples(const float* samples, int numSamples)
+    {
+        if (executionMode == ExecutionMode::backgroundThread)
+            intake.write(samples, numSamples);
+        else
+            writeToHistory(samples, numSamples);
+    }
+
+    void SpectrumAnalyserEngine::writeToHistory(const float* samples, int numSamples)
+    {
+        // Part-way through a transaction the history may not have been sized for the new settings yet, and it'll be
+        // cleared once it has been anyway.
+        if (pendingUpdates.historySize)
+            return;
+
+        writeToBand(*bands[0], samples, numSamples);
+
+        if (bands.size() < 2)
+            return;
+
+        // Each band is fed by decimating the samples of the band above it, a block at a time so the decimated samples
+        // always fit in the workspace.
+        for (auto start = 0; start < numSamples; start += maxDecimationBlockSize)
+        {
+            auto* blockSamples = samples + start;
+            auto numBlockSamples = juce::jmin(maxDecimationBlockSize, numSamples - start);
+
+            for (auto band = 1; band < bands.size(); band++)
+            {
+                numBlockSamples = bands[band]->decimator.process(blockSamples, numBlockSamples, decimationWorkspace.data());
+                blockSamples = decimationWorkspace.data();
+
+                writeToBand(*bands[band], blockSamples, numBlockSamples);
+            }
+        }
+    }
+
+    void SpectrumAnalyserEngine::writeToBand(ResolutionBand& band, const float* samples, int numSamples)
     {
-        for (auto& sample : samples)
-            buffer.write(sample);
+        band.history.write(samples, static_cast<std::size_t>(numSamples));
+        hasNewSamples = true;
+
+        const auto range = juce::FloatVectorOperations::findMinAndMax(samples, numSamples);
+
+        if (range.getStart() == 0.f && range.getEnd() == 0.f)
+        {
+            band.numSilentSamples = juce::jmin(band.numSilentSamples + static_cast<std::size_t>(numSamples),
+                                               band.history.size());
+        }
+        else
+        {
+            band.numSilentSamples = 0;
+        }
+
+        // Anything older than the buffer can't be analysed anyway.
+        band.numPendingSamples = juce::jmin(band.numPendingSamples + static_cast<std::size_t>(numSamples),
+                                            band.history.size());
     }
 
     //==================================================================================================================
@@ -55,6 +193,24 @@ namespace jump
         setProperty(PropertyIDs::fftOrderId, newFFTOrder);
     }
 
+    void SpectrumAnalyserEngine::setWindowLength(int newWindowLength)
+    {
+        jassert(newWindowLength >= 0);
+
+        setProperty(PropertyIDs::windowLengthId, newWindowLength);
+    }
+
+    int SpectrumAnalyserEngine::getWindowLength() const noexcept
+    {
+        if (fft.get() == nullptr)
+            return 0;
+
+        if (windowLength <= 0)
+            return fft->getSize();
+
+        return juce::jmin(windowLength, fft->getSize());
+    }
+
     void SpectrumAnalyserEngine::setFrequencyRange(const juce::NormalisableRange<float>& newFrequencyRange)
     {
         jassert(newFrequencyRange.start > 0.f);
@@ -113,89 +269,575 @@ namespace jump
         return nyquistFrequency;
     }
 
+    const std::vector<juce::Point<float>>& SpectrumAnalyserEngine::getLatestPoints() const noexcept
+    {
+        if (executionMode == ExecutionMode::backgroundThread)
+            return pointFrames.getReadBuffer();
+
+        return points;
+    }
+
+    void SpectrumAnalyserEngine::setOverlap(float newOverlap)
+    {
+        jassert(newOverlap >= 0.f && newOverlap < 1.f);
+
+        setProperty(PropertyIDs::overlapId, newOverlap);
+    }
+
+    int SpectrumAnalyserEngine::getHopSize() const noexcept
+    {
+        if (fft.get() == nullptr)
+            return 1;
+
+        return juce::jmax(1, juce::roundToInt(static_cast<float>(getWindowLength()) * (1.f - overlap)));
+    }
+
+    void SpectrumAnalyserEngine::setAveragingMode(AveragingMode newAveragingMode)
+    {
+        setProperty(PropertyIDs::averagingModeId, var_cast<AveragingMode>(newAveragingMode));
+    }
+
+    void SpectrumAnalyserEngine::setAveragingTime(float newAveragingTimeMs)
+    {
+        jassert(newAveragingTimeMs > 0.f);
+
+        setProperty(PropertyIDs::averagingTimeId, newAveragingTimeMs);
+    }
+
+    void SpectrumAnalyserEngine::setMaxFramesPerUpdate(int newMaxFramesPerUpdate)
+    {
+        jassert(newMaxFramesPerUpdate > 0);
+
+        setProperty(PropertyIDs::maxFramesPerUpdateId, newMaxFramesPerUpdate);
+    }
+
+    void SpectrumAnalyserEngine::setExecutionMode(ExecutionMode newExecutionMode)
+    {
+        setProperty(PropertyIDs::executionModeId, var_cast<ExecutionMode>(newExecutionMode));
+    }
+
+    void SpectrumAnalyserEngine::setBinAggregation(BinAggregation newBinAggregation)
+    {
+        setProperty(PropertyIDs::binAggregationId, var_cast<BinAggregation>(newBinAggregation));
+    }
+
+    void SpectrumAnalyserEngine::setNumResolutionBands(int newNumResolutionBands)
+    {
+        jassert(newNumResolutionBands > 0);
+
+        setProperty(PropertyIDs::numResolutionBandsId, newNumResolutionBands);
+    }
+
+    float SpectrumAnalyserEngine::getCrossoverFrequency(int band) const noexcept
+    {
+        // The first band has no band above it to cross over from.
+        jassert(band > 0);
+
+        return nyquistFrequency / static_cast<float>(1 << (band + 1));
+    }
+
+    void SpectrumAnalyserEngine::setSmoothing(Smoothing newSmoothing)
+    {
+        setProperty(PropertyIDs::smoothingId, var_cast<Smoothing>(newSmoothing));
+    }
+
     //==================================================================================================================
-    SpectrumAnalyserEngine::AnalyserPointInfo::AnalyserPointInfo(int fftBinIndex, float frequency,
+    void SpectrumAnalyserEngine::Decimator::reset() noexcept
+    {
+        history.fill(0.f);
+        writePosition = 0;
+        outputNextSample = false;
+    }
+
+    int SpectrumAnalyserEngine::Decimator::process(const float* source, int numSamples, float* destination) noexcept
+    {
+        const auto& coefficients = getCoefficients();
+        auto numOutputSamples = 0;
+
+        for (auto i = 0; i < numSamples; i++)
+        {
+            history[writePosition] = source[i];
+            history[writePosition + numTaps] = source[i];
+            writePosition = (writePosition + 1) % numTaps;
+
+            // Only every other output is kept, so the others needn't be calculated at all. The coefficients are
+            // symmetrical so it doesn't matter that they're applied to the oldest sample first.
+            if (outputNextSample)
+            {
+                destination[numOutputSamples++] = std::inner_product(coefficients.begin(),
+                                                                     coefficients.end(),
+                                                                     history.begin() + writePosition,
+                                                                     0.f);
+            }
+
+            outputNextSample = !outputNextSample;
+        }
+
+        return numOutputSamples;
+    }
+
+    const std::array<float, SpectrumAnalyserEngine::Decimator::numTaps>&
+        SpectrumAnalyserEngine::Decimator::getCoefficients() noexcept
+    {
+        // A Blackman-windowed sinc with its cutoff at half the nyquist frequency, normalised to unity gain.
+        static const auto coefficients = [] {
+            std::array<double, numTaps> sincs{};
+            const auto centre = static_cast<double>(numTaps / 2);
+
+            for (std::size_t i = 0; i < numTaps; i++)
+            {
+                const auto x = juce::MathConstants<double>::pi * (static_cast<double>(i) - centre) / 2.0;
+                const auto phase = juce::MathConstants<double>::twoPi * static_cast<double>(i) / static_cast<double>(numTaps - 1);
+                const auto window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+
+                sincs[i] = (i == numTaps / 2 ? 1.0 : std::sin(x) / x) * window;
+            }
+
+            const auto sum = std::accumulate(sincs.begin(), sincs.end(), 0.0);
+
+            std::array<float, numTaps> result{};
+            std::transform(sincs.begin(), sincs.end(), result.begin(), [sum](double value) {
+                return static_cast<float>(value / sum);
+            });
+
+            return result;
+        }();
+
+        return coefficients;
+    }
+
+    //==================================================================================================================
+    SpectrumAnalyserEngine::AnalyserPointInfo::AnalyserPointInfo(BinSpan binSpan, BinSpan blendBinSpan,
+                                                                 float blendAmount, float frequency,
                                                                  const juce::NormalisableRange<float>& freqRange)
-        : binIndex{ fftBinIndex }
+        : span{ binSpan }
+        , blendSpan{ blendBinSpan }
+        , blend{ blendAmount }
         , normalisedX{ math::inverseLogSpace(freqRange.start, freqRange.end, frequency) }
     {
     }
 
     //==================================================================================================================
-    [[nodiscard]] static auto getDecibelLevelFromFFTData(const std::vector<float>& fftData, int binIndex, int fftSize,
-                                                         const juce::NormalisableRange<float>& decibelRange)
+    void SpectrumAnalyserEngine::PointEnvelopes::reset(std::size_t numPoints, float minusInfinityDB)
     {
-        const auto gain = fftData[static_cast<std::size_t>(binIndex)] / (fftSize * 2.f);
-        return juce::Decibels::gainToDecibels(gain, decibelRange.start);
+        peakLevels.assign(numPoints, minusInfinityDB);
+        peakTimes.assign(numPoints, 0);
     }
 
-    void SpectrumAnalyserEngine::AnalyserPointInfo::update(const std::vector<float>& fftData, int fftSize,
-                                                           const juce::NormalisableRange<float>& dBRange,
-                                                           juce::uint32 now,
-                                                           float holdTimeMS, float maxHoldTimeMS, float decayTimeMS)
+    bool SpectrumAnalyserEngine::PointEnvelopes::apply(float* levelsDB, juce::uint32 now, float holdTime,
+                                                       float maxHoldTime, float decayTime,
+                                                       const juce::NormalisableRange<float>& decibelRange) noexcept
     {
-        auto newDB = getDecibelLevelFromFFTData(fftData, binIndex, fftSize, dBRange);
+        // The same envelope as applyEnvelopeToDecibelLevel(), but with every branch replaced by a clamp or a blend so
+        // the loop can be vectorised.
+        // A decay time of 0 would make the rate infinite, and multiplying it by the zero elapsed time during a hold
+        // would give NaN. Anything shorter than the timestamps' 1ms resolution still drops the level as soon as the
+        // hold ends.
+        static constexpr auto minDecayTime = 1.0e-3f;
+        const auto decayRate = holdTime < maxHoldTime ? 1.f / juce::jmax(decayTime, minDecayTime) : 0.f;
+        const auto minusInfinityDB = decibelRange.start;
+        auto numNewPeaks = std::size_t{ 0 };
 
-        if (newDB < dB)
-            newDB = applyEnvelopeToDecibelLevel(levelOfLatestPeak, timeOfLatestPeak, now, holdTimeMS, maxHoldTimeMS, decayTimeMS, dBRange);
-        else
+        for (std::size_t i = 0; i < peakLevels.size(); i++)
         {
-            timeOfLatestPeak = juce::Time::getMillisecondCounter();
-            levelOfLatestPeak = newDB;
+            const auto newLevel = levelsDB[i];
+
+            // Converting through a signed integer is much cheaper to vectorise, and still allows for weeks between
+            // peaks.
+            const auto elapsedTime = static_cast<float>(static_cast<std::int32_t>(now - peakTimes[i]));
+            const auto multiplier = juce::jmax(0.f, 1.f - juce::jmax(0.f, elapsedTime - holdTime) * decayRate);
+            const auto decayedLevel = (peakLevels[i] - minusInfinityDB) * multiplier + minusInfinityDB;
+
+            // 1 if the new level starts a new peak, otherwise 0.
+            const auto isNewPeak = newLevel >= decayedLevel ? 1.f : 0.f;
+
+            peakLevels[i] += (newLevel - peakLevels[i]) * isNewPeak;
+            peakTimes[i] += (now - peakTimes[i]) * static_cast<juce::uint32>(isNewPeak);
+            levelsDB[i] = juce::jmax(newLevel, decayedLevel);
+
+            // Counted rather than tested so the loop stays branchless - any point that isn't at a new peak is being
+            // held or decayed.
+            numNewPeaks += static_cast<std::size_t>(isNewPeak);
         }
 
-        dB = newDB;
+        return numNewPeaks == peakLevels.size();
+    }
+
+    //==================================================================================================================
+    void SpectrumAnalyserEngine::analyseFrame(const float* samples)
+    {
+        // Window the samples straight out of the buffer and into the FFT's workspace.
+        const auto numWindowedSamples = static_cast<int>(windowingTable->size());
+
+        // Anything after the window is zero-padding, which the previous transform will have overwritten.
+        juce::FloatVectorOperations::multiply(fftData.data(), samples, windowingTable->data(), numWindowedSamples);
+        juce::FloatVectorOperations::clear(fftData.data() + numWindowedSamples,
+                                           static_cast<int>(fftData.size()) - numWindowedSamples);
+        fft->performFrequencyOnlyForwardTransform(fftData.data());
     }
 
-    juce::Point<float> SpectrumAnalyserEngine::AnalyserPointInfo::normalise(const juce::NormalisableRange<float>& dBRange)
+    static void squareRootInto(std::vector<float>& destination, const std::vector<float>& source)
     {
-        return { normalisedX, 1.f - dBRange.convertTo0to1(dBRange.snapToLegalValue(dB)) };
+        std::transform(source.begin(), source.end(), destination.begin(), [](float value) {
+            return std::sqrt(value);
+        });
     }
 
-    //==================================================================================================================
-    [[nodiscard]] static auto getFFTData(CircularBuffer<float>& buffer, juce::dsp::FFT& fft, juce::dsp::WindowingFunction<float>& windowingFunction)
+    void SpectrumAnalyserEngine::updateSpectrum(ResolutionBand& band, float bandSampleRate)
+    {
+        const auto numFrames = beginSpectrumUpdate(band);
+
+        // Oldest frame first so the exponential average ends on the newest frame.
+        for (auto frame = numFrames - 1; frame >= 0; frame--)
+        {
+            analyseFrame(getFrameSamples(band, frame));
+            addFrameToSpectrum(band, fftData.data(), numFrames, bandSampleRate);
+        }
+
+        if (numFrames > 0)
+            finishSpectrumUpdate(band);
+    }
+
+    int SpectrumAnalyserEngine::beginSpectrumUpdate(ResolutionBand& band)
     {
-        auto fftData = buffer.read();
-        fftData.resize(static_cast<std::size_t>(fft.getSize()) * 2, 0.f);
+        if (averagingMode == AveragingMode::none)
+        {
+            band.numPendingSamples = 0;
+            return 1;
+        }
+
+        const auto hopSize = static_cast<std::size_t>(getHopSize());
+        const auto numNewFrames = static_cast<int>(band.numPendingSamples / hopSize);
+
+        // If a whole hop hasn't arrived yet, the previous spectrum still stands.
+        if (numNewFrames == 0)
+            return 0;
 
-        windowingFunction.multiplyWithWindowingTable(fftData.data(), fftData.size());
-        fft.performFrequencyOnlyForwardTransform(fftData.data());
+        // Samples that arrived after the newest complete hop are left for the next update.
+        band.numPendingSamples %= hopSize;
 
-        return fftData;
+        if (averagingMode != AveragingMode::exponential)
+        {
+            const auto numBins = static_cast<int>(band.spectrum.size());
+
+            juce::FloatVectorOperations::clear(band.spectrum.data(), numBins);
+            juce::FloatVectorOperations::clear(band.powerAccumulator.data(), numBins);
+        }
+
+        return juce::jmin(numNewFrames, maxFramesPerUpdate);
     }
 
-    void SpectrumAnalyserEngine::update(juce::uint32 now)
+    const float* SpectrumAnalyserEngine::getFrameSamples(const ResolutionBand& band, int frame) const noexcept
     {
-        if (fft.get() == nullptr)
-            return;
+        const auto frameSize = static_cast<std::size_t>(getWindowLength());
+        const auto hopSize = static_cast<std::size_t>(getHopSize());
+
+        return band.history.getMostRecent(frameSize + band.numPendingSamples + static_cast<std::size_t>(frame) * hopSize);
+    }
 
-        const auto fftData = getFFTData(buffer, *fft, *windowingFunction);
+    void SpectrumAnalyserEngine::addFrameToSpectrum(ResolutionBand& band, float* magnitudes, int numFrames,
+                                                    float bandSampleRate)
+    {
+        auto& spectrum = band.spectrum;
+        auto& powerAccumulator = band.powerAccumulator;
+        const auto numBins = static_cast<int>(spectrum.size());
+
+        switch (averagingMode)
+        {
+            case AveragingMode::none:
+                std::copy_n(magnitudes, spectrum.size(), spectrum.begin());
+                return;
+            case AveragingMode::peakHold:
+                juce::FloatVectorOperations::max(spectrum.data(), spectrum.data(), magnitudes, numBins);
+                return;
+            case AveragingMode::welch:
+            case AveragingMode::exponential:
+                break;
+        }
+
+        // Averaging is done in the power domain.
+        juce::FloatVectorOperations::multiply(magnitudes, magnitudes, numBins);
 
-        if (fftData.size() == 0)
+        if (averagingMode == AveragingMode::welch)
+        {
+            juce::FloatVectorOperations::addWithMultiply(powerAccumulator.data(), magnitudes,
+                                                         1.f / static_cast<float>(numFrames), numBins);
             return;
+        }
+
+        const auto hopSize = static_cast<float>(getHopSize());
+        const auto coefficient = bandSampleRate > 0.f
+                                   ? std::exp(-hopSize * 1000.f / (bandSampleRate * averagingTime))
+                                   : 0.f;
+
+        juce::FloatVectorOperations::multiply(powerAccumulator.data(), coefficient, numBins);
+        juce::FloatVectorOperations::addWithMultiply(powerAccumulator.data(), magnitudes, 1.f - coefficient, numBins);
+    }
+
+    void SpectrumAnalyserEngine::finishSpectrumUpdate(ResolutionBand& band)
+    {
+        if (averagingMode == AveragingMode::welch || averagingMode == AveragingMode::exponential)
+            squareRootInto(band.spectrum, band.powerAccumulator);
+    }
+
+    float SpectrumAnalyserEngine::getBandSampleRate(int band) const noexcept
+    {
+        return nyquistFrequency * 2.f / static_cast<float>(1 << band);
+    }
+
+    static void updateCumulativePower(std::vector<double>& cumulativePower, const std::vector<float>& spectrum)
+    {
+        // A running sum of the power lets the mean over any span of bins be found with a single subtraction.
+        for (std::size_t bin = 0; bin < spectrum.size(); bin++)
+        {
+            const auto power = static_cast<double>(spectrum[bin]) * static_cast<double>(spectrum[bin]);
+            cumulativePower[bin + 1] = cumulativePower[bin] + power;
+        }
+    }
+
+    bool SpectrumAnalyserEngine::isIdle() const noexcept
+    {
+        // While a point is being held or decaying the points change whether or not there are new samples.
+        if (!envelopesSettled)
+            return false;
+
+        if (!hasNewSamples)
+            return true;
+
+        // More silence can't change a spectrum that's already at -inf dB.
+        if (!pointsAtMinusInfinity)
+            return false;
+
+        for (const auto* band : bands)
+        {
+            if (band->numSilentSamples < band->history.size())
+                return false;
+        }
+
+        return true;
+    }
 
-        auto prevBin = -1;
+    bool SpectrumAnalyserEngine::calculatePoints(juce::uint32 now, std::vector<juce::Point<float>>& destination)
+    {
+        // Part-way through a transaction the FFT, history and point tables may not match each other yet.
+        if (fft.get() == nullptr || bands.isEmpty() || hasPendingUpdates())
+        {
+            isIdling.store(false, std::memory_order_relaxed);
+            return false;
+        }
+
+        const auto idle = isIdle();
+        isIdling.store(idle, std::memory_order_relaxed);
+
+        if (idle)
+        {
+            hasNewSamples = false;
+            return false;
+        }
+
+        // Without new samples the spectra would come out the same, so only the envelopes need updating.
+        if (hasNewSamples)
+        {
+            for (auto i = 0; i < bands.size(); i++)
+                updateSpectrum(*bands[i], getBandSampleRate(i));
+
+            hasNewSamples = false;
+        }
+
+        return calculatePointsFromSpectra(now, destination);
+    }
+
+    bool SpectrumAnalyserEngine::calculatePointsFromSpectra(juce::uint32 now,
+                                                            std::vector<juce::Point<float>>& destination)
+    {
+        for (auto* band : bands)
+        {
+            if (band->spectrum.size() == 0)
+                return false;
+
+            if (smoothing != Smoothing::none)
+            {
+                updateCumulativePower(band->cumulativePower, band->spectrum);
+                smoothSpectrum(*band);
+            }
+
+            if (binAggregation == BinAggregation::meanPower)
+                updateCumulativePower(band->cumulativePower, getDisplaySpectrum(*band));
+        }
+
+        const auto numPointInfos = static_cast<int>(pointsInfo.size());
+
+        for (std::size_t i = 0; i < pointsInfo.size(); i++)
+        {
+            const auto& pointInfo = pointsInfo[i];
+            pointLevels[i] = aggregateBins(pointInfo.span);
+
+            if (pointInfo.blend > 0.f)
+                pointLevels[i] = juce::jmap(pointInfo.blend, pointLevels[i], aggregateBins(pointInfo.blendSpan));
+        }
+
+        // The magnitudes are converted to Decibels, and later normalised, in batches rather than one point at a time.
+        DecibelVectorOperations::gainsToDecibels(pointLevels.data(), pointLevels.data(), numPointInfos,
+                                                 1.f / (static_cast<float>(getWindowLength()) * 2.f), decibelRange.start);
+
+        envelopesSettled = pointEnvelopes.apply(pointLevels.data(), now, holdTime, maxHoldTime, decayTime,
+                                                decibelRange);
+        pointsAtMinusInfinity = juce::FloatVectorOperations::findMaximum(pointLevels.data(), numPointInfos)
+                             <= decibelRange.start;
+
+        DecibelVectorOperations::decibelsToNormalised(pointLevels.data(), pointLevels.data(), numPointInfos,
+                                                      decibelRange);
+
+        auto prevSpan = BinSpan{ -1, { -1, -1 }, 0.f };
+
+        // The destination was reserved in updateBinRange() so this never allocates.
+        destination.clear();
+
+        for (std::size_t i = 0; i < pointsInfo.size(); i++)
+        {
+            const auto& span = pointsInfo[i].span;
+
+            if (binAggregation == BinAggregation::interpolated || prevSpan.band != span.band || prevSpan.bins != span.bins)
+                destination.push_back({ pointsInfo[i].normalisedX, 1.f - pointLevels[i] });
+
+            prevSpan = span;
+        }
+
+        return true;
+    }
+
+    void SpectrumAnalyserEngine::publishPointsFromSpectra(juce::uint32 now)
+    {
+        if (calculatePointsFromSpectra(now, points))
+            renderers.call(&SpectrumAnalyserRendererBase::newSpectrumAnalyserPointsAvailable, *this, points);
+    }
+
+    void SpectrumAnalyserEngine::notifyContinuousRenderers(const std::vector<juce::Point<float>>& latestPoints)
+    {
+        // An idle engine's points are the same as last time, so these renderers are simply passed them again.
+        renderers.call([this, &latestPoints](SpectrumAnalyserRendererBase& renderer) {
+            if (renderer.needsContinuousUpdates())
+                renderer.newSpectrumAnalyserPointsAvailable(*this, latestPoints);
+        });
+    }
+
+    void SpectrumAnalyserEngine::smoothSpectrum(ResolutionBand& band) const noexcept
+    {
+        // Each bin's mean power is found from the running sum with a single subtraction, so the cost doesn't depend on
+        // how many bins the smoothing covers.
+        for (std::size_t bin = 0; bin < smoothingSpans.size(); bin++)
+        {
+            const auto& span = smoothingSpans[bin];
+            const auto start = static_cast<std::size_t>(span.getStart());
+            const auto end = static_cast<std::size_t>(span.getEnd());
+
+            const auto meanPower = (band.cumulativePower[end] - band.cumulativePower[start]) / span.getLength();
+            band.smoothedSpectrum[bin] = static_cast<float>(std::sqrt(juce::jmax(meanPower, 0.0)));
+        }
+    }
+
+    const std::vector<float>& SpectrumAnalyserEngine::getDisplaySpectrum(const ResolutionBand& band) const noexcept
+    {
+        return smoothing == Smoothing::none ? band.spectrum : band.smoothedSpectrum;
+    }
+
+    float SpectrumAnalyserEngine::aggregateBins(const BinSpan& binSpan) const noexcept
+    {
+        const auto& spectrum = getDisplaySpectrum(*bands[binSpan.band]);
+        const auto& cumulativePower = bands[binSpan.band]->cumulativePower;
 
-        std::vector<juce::Point<float>> points;
-        points.reserve(static_cast<std::size_t>(numPoints));
+        const auto start = static_cast<std::size_t>(binSpan.bins.getStart());
+        const auto end = static_cast<std::size_t>(binSpan.bins.getEnd());
 
-        for (auto& pointInfo : pointsInfo)
+        switch (binAggregation)
         {
-            pointInfo.update(fftData, fft->getSize(), decibelRange, now, holdTime, maxHoldTime, decayTime);
+            case BinAggregation::max:
+                return juce::FloatVectorOperations::findMaximum(spectrum.data() + start, binSpan.bins.getLength());
+            case BinAggregation::meanPower:
+            {
+                const auto meanPower = (cumulativePower[end] - cumulativePower[start]) / binSpan.bins.getLength();
+                return static_cast<float>(std::sqrt(juce::jmax(meanPower, 0.0)));
+            }
+            case BinAggregation::interpolated:
+            {
+                const auto lastBin = static_cast<int>(spectrum.size()) - 1;
+                const auto lowerBin = juce::jlimit(0, lastBin, static_cast<int>(binSpan.binPosition));
+                const auto upperBin = juce::jmin(lowerBin + 1, lastBin);
+                const auto proportion = juce::jlimit(0.f, 1.f, binSpan.binPosition - static_cast<float>(lowerBin));
 
-            if (prevBin != pointInfo.binIndex)
-                points.push_back(pointInfo.normalise(decibelRange));
+                return juce::jmap(proportion,
+                                  spectrum[static_cast<std::size_t>(lowerBin)],
+                                  spectrum[static_cast<std::size_t>(upperBin)]);
+            }
+        }
+
+        // Unhandled aggregation method.
+        jassertfalse;
+        return 0.f;
+    }
 
-            prevBin = pointInfo.binIndex;
+    void SpectrumAnalyserEngine::update(juce::uint32 now)
+    {
+        if (executionMode == ExecutionMode::backgroundThread)
+        {
+            analysisInterval.store(getUpdateInterval(), std::memory_order_relaxed);
+
+            if (pointFrames.acquireLatest())
+            {
+                renderers.call(&SpectrumAnalyserRendererBase::newSpectrumAnalyserPointsAvailable,
+                               *this,
+                               pointFrames.getReadBuffer());
+            }
+            else if (isIdling.load(std::memory_order_relaxed))
+            {
+                notifyContinuousRenderers(pointFrames.getReadBuffer());
+            }
+
+            return;
         }
 
-        renderers.call(&SpectrumAnalyserRendererBase::newSpectrumAnalyserPointsAvailable, *this, points);
+        if (calculatePoints(now, points))
+            renderers.call(&SpectrumAnalyserRendererBase::newSpectrumAnalyserPointsAvailable, *this, points);
+        else if (isIdling.load(std::memory_order_relaxed))
+            notifyContinuousRenderers(points);
+    }
+
+    int SpectrumAnalyserEngine::useTimeSlice()
+    {
+        {
+            const juce::ScopedLock lock{ analysisLock };
+
+            intake.read([this](const float* samples, int numSamples) {
+                writeToHistory(samples, numSamples);
+            });
+
+            if (calculatePoints(juce::Time::getMillisecondCounter(), pointFrames.getWriteBuffer()))
+                pointFrames.publish();
+        }
+
+        return analysisInterval.load(std::memory_order_relaxed);
     }
 
     void SpectrumAnalyserEngine::propertyChanged(const juce::Identifier& name, const juce::var& newValue)
     {
+        // Changing the execution mode waits for the background thread, so mustn't be done while holding the lock it
+        // needs.
+        if (name == PropertyIDs::executionModeId)
+        {
+            setExecutionModeInternal(var_cast<ExecutionMode>(newValue));
+            return;
+        }
+
+        const juce::ScopedLock lock{ analysisLock };
+
+        // Any change of settings could change the points, so the engine mustn't idle through the next update.
+        hasNewSamples = true;
+        envelopesSettled = false;
+
         if (name == PropertyIDs::fftOrderId)
             setFFTOrderInternal(newValue);
+        else if (name == PropertyIDs::windowLengthId)
+            setWindowLengthInternal(newValue);
         else if (name == SharedPropertyIDs::sampleRateId)
             setSampleRateInternal(newValue);
         else if (name == PropertyIDs::frequencyRangeId)
@@ -209,9 +851,44 @@ namespace jump
         else if (name == PropertyIDs::decayTimeId)
             decayTime = newValue;
         else if (name == PropertyIDs::numPointsId)
+        {
             numPoints = newValue;
+            updateBinRange();
+        }
+        else if (name == PropertyIDs::binAggregationId)
+            binAggregation = var_cast<BinAggregation>(newValue);
+        else if (name == PropertyIDs::smoothingId)
+        {
+            smoothing = var_cast<Smoothing>(newValue);
+            updateSmoothingSpans();
+        }
+        else if (name == PropertyIDs::numResolutionBandsId)
+            setNumResolutionBandsInternal(newValue);
+        else if (name == PropertyIDs::overlapId)
+        {
+            overlap = newValue;
+            updateHistorySize();
+        }
+        else if (name == PropertyIDs::averagingModeId)
+        {
+            averagingMode = var_cast<AveragingMode>(newValue);
+
+            for (auto* band : bands)
+                juce::FloatVectorOperations::clear(band->powerAccumulator.data(),
+                                                   static_cast<int>(band->powerAccumulator.size()));
+        }
+        else if (name == PropertyIDs::averagingTimeId)
+            averagingTime = newValue;
+        else if (name == PropertyIDs::maxFramesPerUpdateId)
+        {
+            maxFramesPerUpdate = newValue;
+            updateHistorySize();
+        }
         else if (name == PropertyIDs::windowingMethodId)
+        {
             windowingMethod = var_cast<WindowingMethod>(newValue);
+            updateWindowingTable();
+        }
         else
         {
             // Unhandled property ID.
@@ -219,49 +896,257 @@ namespace jump
         }
     }
 
+    void SpectrumAnalyserEngine::transactionCommitted()
+    {
+        const juce::ScopedLock lock{ analysisLock };
+
+        const auto updates = std::exchange(pendingUpdates, {});
+
+        // In the same order setFFTOrderInternal() does them, as each may depend on the ones before.
+        if (updates.historySize)
+            updateHistorySize();
+
+        if (updates.bandSpectra)
+            updateBandSpectra();
+        else if (updates.smoothingSpans)
+            updateSmoothingSpans();
+
+        if (updates.windowingTable)
+            updateWindowingTable();
+
+        if (updates.binRange)
+            updateBinRange();
+    }
+
     //==================================================================================================================
+    bool SpectrumAnalyserEngine::deferUntilCommitted(bool& pendingUpdate) noexcept
+    {
+        if (!isInTransaction())
+            return false;
+
+        pendingUpdate = true;
+        return true;
+    }
+
+    bool SpectrumAnalyserEngine::hasPendingUpdates() const noexcept
+    {
+        return pendingUpdates.historySize || pendingUpdates.bandSpectra || pendingUpdates.smoothingSpans
+            || pendingUpdates.windowingTable || pendingUpdates.binRange;
+    }
+
     void SpectrumAnalyserEngine::updateBinRange()
     {
-        if (fft.get() == nullptr)
+        if (deferUntilCommitted(pendingUpdates.binRange))
+            return;
+
+        if (fft.get() == nullptr || nyquistFrequency <= 0.f || numPoints < 2)
             return;
 
         const auto numBinsUpToNyquist = fft->getSize() / 2;
+        const auto binsPerHz = static_cast<float>(numBinsUpToNyquist) / nyquistFrequency;
 
-        binRange.setStart(juce::roundToInt(numBinsUpToNyquist * frequencyRange.start / nyquistFrequency));
-        binRange.setEnd(juce::roundToInt(numBinsUpToNyquist * frequencyRange.end / nyquistFrequency));
+        binRange.setStart(juce::roundToInt(frequencyRange.start * binsPerHz));
+        binRange.setEnd(juce::roundToInt(frequencyRange.end * binsPerHz));
 
         if (binRange.getEnd() == 0)
             return;
 
+        // Each point covers the bins between the (geometric) midpoints to its neighbouring points.
+        const auto halfStep = std::pow(frequencyRange.end / frequencyRange.start, 0.5f / static_cast<float>(numPoints - 1));
+
         pointsInfo.clear();
         pointsInfo.reserve(static_cast<std::size_t>(numPoints));
 
         for (auto& frequency : math::logRange(frequencyRange.start, frequencyRange.end, numPoints))
         {
-            const auto binIndex = juce::roundToInt(juce::jmap(frequency,
-                                                              frequencyRange.start, frequencyRange.end,
-                                                              static_cast<float>(binRange.getStart()), static_cast<float>(binRange.getEnd())));
+            // Each point uses the finest band that covers its frequency...
+            auto band = 0;
+
+            while (band + 1 < bands.size()
+                   && frequency < getCrossoverFrequency(band + 1) * juce::MathConstants<float>::sqrt2)
+            {
+                band++;
+            }
+
+            // ...fading into the band above it over the octave centred on their crossover.
+            const auto blend = band > 0
+                                 ? juce::jlimit(0.f, 1.f, 0.5f + std::log2(frequency / getCrossoverFrequency(band)))
+                                 : 0.f;
+            const auto span = getBinSpan(band, frequency, halfStep);
+
+            pointsInfo.push_back({ span,
+                                   blend > 0.f ? getBinSpan(band - 1, frequency, halfStep) : span,
+                                   blend,
+                                   frequency,
+                                   frequencyRange });
+        }
+
+        pointEnvelopes.reset(pointsInfo.size(), decibelRange.start);
+        pointLevels.resize(pointsInfo.size());
+        points.reserve(pointsInfo.size());
+        pointFrames.forEachFrame([this](std::vector<juce::Point<float>>& frame) {
+            frame.reserve(pointsInfo.size());
+        });
+    }
+
+    SpectrumAnalyserEngine::BinSpan SpectrumAnalyserEngine::getBinSpan(int band,
+                                                                       float frequency,
+                                                                       float halfStep) const noexcept
+    {
+        // Each band has the same number of bins over half the bandwidth of the band above it.
+        const auto numBinsUpToNyquist = fft->getSize() / 2;
+        const auto binsPerHz = static_cast<float>(numBinsUpToNyquist) * static_cast<float>(1 << band) / nyquistFrequency;
+        const auto binPosition = frequency * binsPerHz;
+
+        auto bins = juce::Range<int>{ 0, numBinsUpToNyquist + 1 }
+                        .getIntersectionWith({ juce::roundToInt(frequency / halfStep * binsPerHz),
+                                               juce::roundToInt(frequency * halfStep * binsPerHz) });
+
+        // Points narrower than a bin just use the nearest one.
+        if (bins.isEmpty())
+            bins = juce::Range<int>::withStartAndLength(juce::jmin(juce::roundToInt(binPosition), numBinsUpToNyquist), 1);
+
+        return { band, bins, binPosition };
+    }
+
+    void SpectrumAnalyserEngine::updateWindowingTable()
+    {
+        if (deferUntilCommitted(pendingUpdates.windowingTable))
+            return;
+
+        if (fft.get() == nullptr)
+            return;
+
+        windowingTable = fftCache->getWindowingTable(getWindowLength(), windowingMethod);
+    }
+
+    void SpectrumAnalyserEngine::updateHistorySize()
+    {
+        if (deferUntilCommitted(pendingUpdates.historySize))
+            return;
+
+        if (fft.get() == nullptr || bands.isEmpty())
+            return;
+
+        // Enough history for the largest backlog of frames that can be analysed in a single update.
+        const auto numFrames = static_cast<std::size_t>(juce::jmax(maxFramesPerUpdate, 1));
+        const auto historySize = static_cast<std::size_t>(getWindowLength())
+                               + numFrames * static_cast<std::size_t>(getHopSize());
+
+        for (auto* band : bands)
+        {
+            band->history.resize(historySize);
+            band->numPendingSamples = 0;
+            band->numSilentSamples = 0;
+            band->decimator.reset();
+        }
+
+        // Anything more than the history can hold couldn't be analysed anyway.
+        if (executionMode == ExecutionMode::backgroundThread)
+            intake.setCapacity(static_cast<int>(bands[0]->history.size()));
+    }
+
+    void SpectrumAnalyserEngine::updateBandSpectra()
+    {
+        if (deferUntilCommitted(pendingUpdates.bandSpectra))
+            return;
+
+        if (fft.get() == nullptr)
+            return;
+
+        const auto numBins = static_cast<std::size_t>(fft->getSize() / 2 + 1);
+
+        for (auto* band : bands)
+        {
+            band->spectrum.assign(numBins, 0.f);
+            band->smoothedSpectrum.assign(numBins, 0.f);
+            band->powerAccumulator.assign(numBins, 0.f);
+            band->cumulativePower.assign(numBins + 1, 0.0);
+        }
+
+        updateSmoothingSpans();
+    }
+
+    void SpectrumAnalyserEngine::updateSmoothingSpans()
+    {
+        if (deferUntilCommitted(pendingUpdates.smoothingSpans))
+            return;
+
+        if (fft.get() == nullptr)
+            return;
 
-            pointsInfo.push_back({ binIndex, frequency, frequencyRange });
+        const auto octaveFraction = [this]() {
+            switch (smoothing)
+            {
+                case Smoothing::none:
+                    return 0;
+                case Smoothing::octave:
+                    return 1;
+                case Smoothing::thirdOctave:
+                    return 3;
+                case Smoothing::sixthOctave:
+                    return 6;
+                case Smoothing::twelfthOctave:
+                    return 12;
+                case Smoothing::twentyFourthOctave:
+                    return 24;
+            }
+
+            // Unhandled smoothing.
+            jassertfalse;
+            return 0;
+        }();
+
+        if (octaveFraction == 0)
+        {
+            smoothingSpans.clear();
+            return;
+        }
+
+        const auto numBins = fft->getSize() / 2 + 1;
+        const auto halfWidth = std::pow(2.f, 0.5f / static_cast<float>(octaveFraction));
+
+        smoothingSpans.resize(static_cast<std::size_t>(numBins));
+
+        // Each bin covers the bins whose frequencies lie within the fraction of an octave centred on it, which always
+        // includes the bin itself.
+        for (auto bin = 0; bin < numBins; bin++)
+        {
+            const auto start = static_cast<int>(std::ceil(static_cast<float>(bin) / halfWidth));
+            const auto end = static_cast<int>(std::floor(static_cast<float>(bin) * halfWidth)) + 1;
+
+            smoothingSpans[static_cast<std::size_t>(bin)] = { juce::jlimit(0, bin, start),
+                                                              juce::jlimit(bin + 1, numBins, end) };
         }
     }
 
     //==================================================================================================================
     void SpectrumAnalyserEngine::setFFTOrderInternal(int newFFTOrder)
     {
-        fft.reset(new juce::dsp::FFT{ newFFTOrder });
-        windowingFunction.reset(new juce::dsp::WindowingFunction<float>{ static_cast<std::size_t>(1) << newFFTOrder, windowingMethod });
-        buffer.resize(1 << newFFTOrder);
+        fft = fftCache->getFFT(newFFTOrder);
+        updateHistorySize();
+
+        fftData.resize(static_cast<std::size_t>(fft->getSize()) * 2, 0.f);
+        updateBandSpectra();
+        updateWindowingTable();
 
         if (newFFTOrder > 0)
         {
-            // You need to call setSampleRate first before calling setFFTOrder.
-            jassert(nyquistFrequency > 0.f);
+            // You need to call setSampleRate first before calling setFFTOrder, unless they're both set within the same
+            // transaction.
+            jassert(nyquistFrequency > 0.f || isInTransaction());
 
             updateBinRange();
         }
     }
 
+    void SpectrumAnalyserEngine::setWindowLengthInternal(int newWindowLength)
+    {
+        windowLength = newWindowLength;
+        updateHistorySize();
+        updateWindowingTable();
+    }
+
     void SpectrumAnalyserEngine::setSampleRateInternal(double newSampleRate)
     {
         nyquistFrequency = static_cast<float>(newSampleRate / 2.0);
@@ -273,4 +1158,61 @@ namespace jump
         frequencyRange = newFrequencyRange;
         updateBinRange();
     }
+
+    void SpectrumAnalyserEngine::setNumResolutionBandsInternal(int newNumResolutionBands)
+    {
+        bands.clear();
+
+        for (auto i = 0; i < juce::jmax(newNumResolutionBands, 1); i++)
+            bands.add(new ResolutionBand{});
+
+        decimationWorkspace.resize(bands.size() > 1 ? maxDecimationBlockSize / 2 : 0);
+
+        updateBandSpectra();
+        updateHistorySize();
+        updateBinRange();
+    }
+
+    void SpectrumAnalyserEngine::setExecutionModeInternal(ExecutionMode newExecutionMode)
+    {
+        if (newExecutionMode == ExecutionMode::backgroundThread)
+        {
+            {
+                const juce::ScopedLock lock{ analysisLock };
+
+                executionMode = newExecutionMode;
+                updateHistorySize();
+            }
+
+            if (analysisThread == nullptr)
+            {
+                analysisThread = std::make_unique<juce::SharedResourcePointer<SharedAnalysisThread>>();
+                (*analysisThread)->addTimeSliceClient(this);
+            }
+        }
+        else
+        {
+            const auto wasInBackground = analysisThread != nullptr;
+
+            // This blocks until the background thread has finished with this engine.
+            if (wasInBackground)
+            {
+                (*analysisThread)->removeTimeSliceClient(this);
+                analysisThread.reset();
+            }
+
+            const juce::ScopedLock lock{ analysisLock };
+
+            executionMode = newExecutionMode;
+            intake.setCapacity(0);
+
+            // The points were last calculated on the background thread, so carry its latest frame over rather than
+            // leaving getLatestPoints() returning whatever was calculated before the engine went into the background.
+            if (wasInBackground)
+            {
+                pointFrames.acquireLatest();
+                points = pointFrames.getReadBuffer();
+            }
+        }
+    }
 } // namespace jump
@@ -15,9 +15,33 @@ namespace jump
         //==============================================================================================================
         /** Derived classes must override this method in order to receive callbacks when a new set of points had been
             calculated by the given engine.
+
+            The points are owned by the engine and remain valid until its next update, so renderers needn't copy them
+            - see SpectrumAnalyserEngine::getLatestPoints().
         */
         virtual void newSpectrumAnalyserPointsAvailable(const SpectrumAnalyserEngine& engine,
                                                         const std::vector<juce::Point<float>>& points) = 0;
+
+        /** Derived classes can override this method to tell the engine whether they're currently visible to the user.
+
+            Engines whose renderers are all hidden are the first to be slowed down when the EngineScheduler runs over
+            budget. Renderers are assumed to be visible by default.
+        */
+        virtual bool isRendererVisible() const
+        {
+            return true;
+        }
+
+        /** Derived classes can override this method to keep receiving points while the engine is idle.
+
+            An idle engine normally stops calling its renderers, since the points wouldn't change. Renderers that draw
+            something over time, such as a spectrogram's history, can return true to instead be passed the latest
+            points on every update. Renderers don't need continuous updates by default.
+        */
+        virtual bool needsContinuousUpdates() const
+        {
+            return false;
+        }
     };
 
     //==================================================================================================================
@@ -30,8 +54,31 @@ namespace jump
         The Y axis of the analyser uses Decibels and will be linear.
         The X axis of the analyser is in Hz and will use a logarithmic scale (base 2) to more accurately represent how
         we as humans perceive pitch.
+
+        By default the analysis is done on the message thread each time the engine updates. Using
+        setExecutionMode(ExecutionMode::backgroundThread) moves the FFT and the calculation of the points onto a
+        background thread shared by all engines, leaving the message thread to simply hand the newest finished set of
+        points to the renderers.
+
+        With a single FFT, log-spaced points end up sharing a handful of bins at low frequencies while each covers
+        hundreds of bins at high frequencies. setNumResolutionBands() splits the analysis into octave bands, each
+        analysing a decimated copy of the signal with the same FFT size, to give much finer resolution in the bass for
+        a fraction of the cost of one large FFT.
+
+        The engine idles when there's nothing new to show: if no samples have been added since the last update, the
+        spectrum isn't analysed again, and once every point's hold and decay has settled the engine stops calculating
+        points and calling its renderers altogether, apart from any that need continuous updates (see
+        SpectrumAnalyserRendererBase::needsContinuousUpdates()), which are passed the latest points again. The same goes
+        for input that's entirely digital silence once every point has settled at the bottom of the Decibel range, so
+        stopped transports, muted tracks and bypassed plugins cost next to nothing.
+
+        Changing several settings at once (e.g. when loading a preset) should be done within a transaction (see
+        createTransaction()) so the FFT workspace, history and point tables are only rebuilt once, rather than once for
+        each setting.
     */
-    class SpectrumAnalyserEngine : public AudioComponentEngine<SpectrumAnalyserRendererBase>
+    class SpectrumAnalyserEngine
+        : public AudioComponentEngine<SpectrumAnalyserRendererBase>
+        , private juce::TimeSliceClient
     {
     public:
         //==============================================================================================================
@@ -39,23 +86,107 @@ namespace jump
         {
             static const inline juce::Identifier windowingMethodId{ "windowingMethod" };
             static const inline juce::Identifier fftOrderId{ "fftOrder" };
+            static const inline juce::Identifier windowLengthId{ "windowLength" };
             static const inline juce::Identifier frequencyRangeId{ "frequencyRange" };
             static const inline juce::Identifier decibelRangeId{ "decibelRange" };
             static const inline juce::Identifier holdTimeId{ "holdTime" };
             static const inline juce::Identifier maxHoldTimeId{ "maxHoldTime" };
             static const inline juce::Identifier decayTimeId{ "decayTime" };
             static const inline juce::Identifier numPointsId{ "numPoints" };
+            static const inline juce::Identifier overlapId{ "overlap" };
+            static const inline juce::Identifier averagingModeId{ "averagingMode" };
+            static const inline juce::Identifier averagingTimeId{ "averagingTime" };
+            static const inline juce::Identifier maxFramesPerUpdateId{ "maxFramesPerUpdate" };
+            static const inline juce::Identifier executionModeId{ "executionMode" };
+            static const inline juce::Identifier binAggregationId{ "binAggregation" };
+            static const inline juce::Identifier numResolutionBandsId{ "numResolutionBands" };
+            static const inline juce::Identifier smoothingId{ "smoothing" };
         };
 
         //==============================================================================================================
         using WindowingMethod = juce::dsp::WindowingFunction<float>::WindowingMethod;
 
+        /** The ways in which the spectra of the frames analysed in each update can be combined. */
+        enum class AveragingMode
+        {
+            /** Only the most recent samples are analysed, once per update. */
+            none,
+
+            /** The power of every frame that arrived since the last update is averaged (Welch's method). */
+            welch,
+
+            /** Every frame is blended into a running average of the power, with a time constant set by
+                setAveragingTime().
+            */
+            exponential,
+
+            /** The highest magnitude of every frame that arrived since the last update is kept, so short transients
+                between updates aren't missed.
+            */
+            peakHold
+        };
+
+        /** The ways in which the FFT bins around each point can be combined into that point's level.
+
+            Each point covers the span of bins between the midpoints to its neighbouring points, so at high frequencies
+            where there are many bins per point no bins are ignored.
+        */
+        enum class BinAggregation
+        {
+            /** The point takes the level of the loudest bin in its span, so narrow peaks are never hidden. */
+            max,
+
+            /** The point takes the mean power of the bins in its span. */
+            meanPower,
+
+            /** The point's level is interpolated between the two bins either side of its exact frequency, giving a
+                smooth curve at low frequencies where there are several points per bin.
+            */
+            interpolated
+        };
+
+        /** The widths of the fractional-octave smoothing that can be applied to the spectrum. */
+        enum class Smoothing
+        {
+            /** The spectrum is left as it is. */
+            none,
+
+            /** Each bin takes the mean power of the bins within an octave centred on it. */
+            octave,
+
+            /** Each bin takes the mean power of the bins within a third of an octave centred on it. */
+            thirdOctave,
+
+            /** Each bin takes the mean power of the bins within a sixth of an octave centred on it. */
+            sixthOctave,
+
+            /** Each bin takes the mean power of the bins within a twelfth of an octave centred on it. */
+            twelfthOctave,
+
+            /** Each bin takes the mean power of the bins within a twenty-fourth of an octave centred on it. */
+            twentyFourthOctave
+        };
+
+        /** The threads on which the engine's analysis can be performed. */
+        enum class ExecutionMode
+        {
+            /** The analysis is done on the message thread each time the engine updates. */
+            messageThread,
+
+            /** The analysis is done on a SharedAnalysisThread and only the finished points are passed back to the
+                message thread.
+            */
+            backgroundThread
+        };
+
         //==============================================================================================================
         SpectrumAnalyserEngine();
         SpectrumAnalyserEngine(const juce::Identifier& uniqueID, StatefulObject* parentState);
+        ~SpectrumAnalyserEngine() override;
 
         //==============================================================================================================
-        void addSamples(const std::vector<float>& samples) override;
+        using AudioComponentEngine::addSamples;
+        void addSamples(const float* samples, int numSamples) override;
 
         //==============================================================================================================
         /** Specifies the sample rate of the samples being added to this engine.
@@ -83,6 +214,21 @@ namespace jump
         */
         void setFFTOrder(int newFFTOrder);
 
+        /** Changes the number of samples that are windowed and analysed in each frame.
+
+            If this is shorter than the FFT size, the windowed samples are zero-padded up to the FFT size. A shorter
+            window responds more quickly to changes in the signal while the larger FFT keeps the spectrum smoothly
+            interpolated between bins, without the latency and cost of analysing more samples.
+
+            The window length is limited to the FFT size. The default is 0, which uses a window as long as the FFT.
+
+            @param newWindowLength  The new window length to use, in samples.
+        */
+        void setWindowLength(int newWindowLength);
+
+        /** Returns the number of samples that are windowed and analysed in each frame. */
+        int getWindowLength() const noexcept;
+
         /** Changes the range of frequencies for which the points will be calculated.
 
             The lower value should be greater than 0, and the upper value should be no greater than the nyquist limit.
@@ -148,8 +294,8 @@ namespace jump
 
         /** Changes the number of points to calculate for the spectrum.
 
-            Note that this is the maximum number of points as some points may be removed if they share the same
-            frequency bin as an existing point (i.e. at low frequencies).
+            Note that this is the maximum number of points as, unless BinAggregation::interpolated is used, some points
+            may be removed if they cover the same frequency bins as an existing point (i.e. at low frequencies).
 
             The default is 256.
 
@@ -160,52 +306,292 @@ namespace jump
         /** Returns the current sample rate being used by this engine. */
         double getNyquistFrequency() const noexcept;
 
+        /** Returns the set of points most recently passed to the renderers.
+
+            The points are held in storage that's sized whenever the FFT size or number of points changes, so no
+            allocations are made as the engine updates. The reference should only be used on the message thread and
+            only remains valid until the engine next updates.
+        */
+        const std::vector<juce::Point<float>>& getLatestPoints() const noexcept;
+
+        /** Changes how much consecutive frames overlap when an averaging mode other than AveragingMode::none is used.
+
+            The hop size between frames is the window length multiplied by (1 - overlap). The value should be at least 0
+            and less than 1.
+
+            The default is 0.5.
+
+            @param newOverlap   The new proportion of overlap to use.
+        */
+        void setOverlap(float newOverlap);
+
+        /** Returns the number of samples between the starts of consecutive frames. */
+        int getHopSize() const noexcept;
+
+        /** Changes how the spectra of the frames that arrived since the last update are combined.
+
+            The default is AveragingMode::none.
+
+            @param newAveragingMode The new averaging mode to use.
+        */
+        void setAveragingMode(AveragingMode newAveragingMode);
+
+        /** Changes the time constant, in milliseconds, of the running average used by AveragingMode::exponential.
+
+            This value should be positive.
+
+            The default is 100ms.
+
+            @param newAveragingTimeMs   The new averaging time to use, in milliseconds.
+        */
+        void setAveragingTime(float newAveragingTimeMs);
+
+        /** Limits the number of frames analysed in a single update.
+
+            If more frames than this arrive between two updates (e.g. because the frame rate dropped) only the most
+            recent ones are analysed, so the cost of an update stays bounded under load.
+
+            The default is 8.
+
+            @param newMaxFramesPerUpdate    The new maximum number of frames to analyse per update.
+        */
+        void setMaxFramesPerUpdate(int newMaxFramesPerUpdate);
+
+        /** Changes the thread on which the analysis is performed.
+
+            In either mode, renderers are only ever called on the message thread. When using
+            ExecutionMode::backgroundThread the renderers receive the most recent set of points the background thread
+            has finished, so any sets that were finished in between updates are skipped.
+
+            The default is ExecutionMode::messageThread.
+
+            @param newExecutionMode The new execution mode to use.
+        */
+        void setExecutionMode(ExecutionMode newExecutionMode);
+
+        /** Changes how the FFT bins around each point are combined into that point's level.
+
+            The default is BinAggregation::max.
+
+            @param newBinAggregation    The new aggregation method to use.
+        */
+        void setBinAggregation(BinAggregation newBinAggregation);
+
+        /** Changes the number of bands the spectrum is analysed in.
+
+            The first band analyses the signal at the full sample rate. Each band after it analyses the previous band's
+            signal low-pass filtered and decimated by 2, so with the same FFT size it has twice the frequency resolution
+            over half the bandwidth. Band n takes over below the nyquist frequency / 2 ^ (n + 1), and neighbouring bands
+            are crossfaded over the octave centred on that crossover so there are no steps in the spectrum.
+
+            The extra resolution comes at the cost of time resolution: each band's window covers twice as much time as
+            the one before it, so the lowest bands respond more slowly to changes in the signal.
+
+            The default is 1, which analyses the whole spectrum with a single FFT.
+
+            @param newNumResolutionBands    The new number of bands to use.
+        */
+        void setNumResolutionBands(int newNumResolutionBands);
+
+        /** Returns the frequency, in Hz, below which the given band takes over from the band above it. */
+        float getCrossoverFrequency(int band) const noexcept;
+
+        /** Changes the fractional-octave smoothing applied to the spectrum before the points are calculated.
+
+            Smoothing averages the power of the bins around each bin over a fixed proportion of an octave, so the
+            spectrum is smoothed more at high frequencies where each octave covers more bins - the way most mix-analysis
+            displays present a spectrum.
+
+            The default is Smoothing::none.
+
+            @param newSmoothing The new smoothing to use.
+        */
+        void setSmoothing(Smoothing newSmoothing);
+
     private:
         //==============================================================================================================
-        class AnalyserPointInfo
+        // Drives the engines of its channels, sharing a single set of transforms between them.
+        friend class MultichannelSpectrumAnalyserEngine;
+        friend class SpectrumAnalyserEngineTests;
+        friend class MultichannelSpectrumAnalyserEngineTests;
+
+        //==============================================================================================================
+        /** Low-pass filters a stream of samples and then discards every other sample, halving its sample rate.
+
+            The filter is a half-band FIR that's flat up to a quarter of the output sample rate, which is the
+            crossover frequency between two bands, and attenuates anything that would alias below the crossover by more
+            than 80dB.
+        */
+        class Decimator
         {
         public:
-            AnalyserPointInfo(int fftBinIndex, float frequency, const juce::NormalisableRange<float>& freqRange);
-
-            void update(const std::vector<float>& fftData, int fftSize,
-                        const juce::NormalisableRange<float>& decibelRange, juce::uint32 now, float holdTime,
-                        float maxHoldTime, float decayTime);
+            /** Clears the filter's history. */
+            void reset() noexcept;
 
-            juce::Point<float> normalise(const juce::NormalisableRange<float>& decibelRange);
+            /** Decimates the given samples, returning the number of samples written to the destination.
 
-            const int binIndex;
+                The destination may be the same as the source.
+            */
+            int process(const float* source, int numSamples, float* destination) noexcept;
 
         private:
+            static constexpr std::size_t numTaps = 47;
+            static const std::array<float, numTaps>& getCoefficients() noexcept;
+
+            // Mirrored so the most recent numTaps samples are always contiguous.
+            std::array<float, numTaps * 2> history{};
+            std::size_t writePosition{ 0 };
+            bool outputNextSample{ false };
+        };
+
+        /** The history and spectrum of one of the bands the analysis is split into. */
+        struct ResolutionBand
+        {
+            MirroredCircularBuffer<float> history;
+            std::size_t numPendingSamples{ 0 };
+
+            // The number of most recent samples that are all digital silence.
+            std::size_t numSilentSamples{ 0 };
+
+            std::vector<float> spectrum;
+            std::vector<float> smoothedSpectrum;
+            std::vector<float> powerAccumulator;
+            std::vector<double> cumulativePower;
+
+            // Feeds this band from the band above it - unused by the first band.
+            Decimator decimator;
+        };
+
+        /** The bins of one band that a point takes its level from. */
+        struct BinSpan
+        {
+            int band;
+            juce::Range<int> bins;
+            float binPosition;
+        };
+
+        //==============================================================================================================
+        class AnalyserPointInfo
+        {
+        public:
+            AnalyserPointInfo(BinSpan binSpan, BinSpan blendBinSpan, float blendAmount, float frequency,
+                              const juce::NormalisableRange<float>& freqRange);
+
+            const BinSpan span;
+
+            // Used in the crossover region between two bands, where the point is a mix of both.
+            const BinSpan blendSpan;
+            const float blend;
+
             const float normalisedX;
+        };
 
-            float dB{ std::numeric_limits<float>::lowest() };
+        /** The hold and decay state of every point, kept in separate contiguous arrays so the envelope can be applied
+            to all of the points in a single pass that the compiler can vectorise.
+        */
+        class PointEnvelopes
+        {
+        public:
+            /** Resizes the arrays to hold the given number of points and resets their peaks to -inf Decibels. */
+            void reset(std::size_t numPoints, float minusInfinityDB);
+
+            /** Replaces each level with its level after the hold and decay are applied.
 
-            juce::uint32 timeOfLatestPeak{ 0 };
-            float levelOfLatestPeak{ std::numeric_limits<float>::lowest() };
+                Returns true if every level was unaffected by the envelope - i.e. no point is still holding or decaying
+                from an earlier peak.
+
+                @see applyEnvelopeToDecibelLevel()
+            */
+            bool apply(float* levelsDB, juce::uint32 now, float holdTime, float maxHoldTime, float decayTime,
+                       const juce::NormalisableRange<float>& decibelRange) noexcept;
+
+        private:
+            std::vector<float> peakLevels;
+            std::vector<juce::uint32> peakTimes;
+        };
+
+        // The rebuilding that's been put off until the current transaction is committed.
+        struct PendingUpdates
+        {
+            bool historySize{ false };
+            bool bandSpectra{ false };
+            bool smoothingSpans{ false };
+            bool windowingTable{ false };
+            bool binRange{ false };
         };
 
         //==============================================================================================================
         void update(juce::uint32 now) override;
         void propertyChanged(const juce::Identifier& name, const juce::var& newValue) override;
+        void transactionCommitted() override;
+        int useTimeSlice() override;
 
         //==============================================================================================================
         void initialise();
+        bool deferUntilCommitted(bool& pendingUpdate) noexcept;
+        bool hasPendingUpdates() const noexcept;
         void updateBinRange();
+        BinSpan getBinSpan(int band, float frequency, float halfStep) const noexcept;
+
+        //==============================================================================================================
+        void updateWindowingTable();
+        void updateHistorySize();
+        void updateBandSpectra();
+        void updateSmoothingSpans();
+        void writeToHistory(const float* samples, int numSamples);
+        void writeToBand(ResolutionBand& band, const float* samples, int numSamples);
+        void updateSpectrum(ResolutionBand& band, float bandSampleRate);
+        int beginSpectrumUpdate(ResolutionBand& band);
+        const float* getFrameSamples(const ResolutionBand& band, int frame) const noexcept;
+        void addFrameToSpectrum(ResolutionBand& band, float* magnitudes, int numFrames, float bandSampleRate);
+        void finishSpectrumUpdate(ResolutionBand& band);
+        float getBandSampleRate(int band) const noexcept;
+        void analyseFrame(const float* samples);
+        bool isIdle() const noexcept;
+        bool calculatePoints(juce::uint32 now, std::vector<juce::Point<float>>& destination);
+        bool calculatePointsFromSpectra(juce::uint32 now, std::vector<juce::Point<float>>& destination);
+        void publishPointsFromSpectra(juce::uint32 now);
+        void notifyContinuousRenderers(const std::vector<juce::Point<float>>& latestPoints);
+        void smoothSpectrum(ResolutionBand& band) const noexcept;
+        const std::vector<float>& getDisplaySpectrum(const ResolutionBand& band) const noexcept;
+        float aggregateBins(const BinSpan& binSpan) const noexcept;
 
         //==============================================================================================================
         void setFFTOrderInternal(int newFFTOrder);
+        void setWindowLengthInternal(int newWindowLength);
         void setSampleRateInternal(double newSampleRate);
         void setFrequencyRangeInternal(const juce::NormalisableRange<float>& newFrequencyRange);
+        void setExecutionModeInternal(ExecutionMode newExecutionMode);
+        void setNumResolutionBandsInternal(int newNumResolutionBands);
 
         //==============================================================================================================
-        CircularBuffer<float> buffer;
+        static constexpr int maxDecimationBlockSize = 1024;
 
-        std::unique_ptr<juce::dsp::FFT> fft;
+        juce::OwnedArray<ResolutionBand> bands;
+        std::vector<float> decimationWorkspace;
+        std::vector<float> fftData;
+
+        // The FFT and windowing table are shared with any other engines using the same settings.
+        juce::SharedResourcePointer<SharedFFTCache> fftCache;
+        std::shared_ptr<const juce::dsp::FFT> fft;
         juce::dsp::WindowingFunction<float>::WindowingMethod windowingMethod;
-        std::unique_ptr<juce::dsp::WindowingFunction<float>> windowingFunction;
+        std::shared_ptr<const std::vector<float>> windowingTable;
         juce::Range<int> binRange;
+        int windowLength{ 0 };
 
         std::vector<AnalyserPointInfo> pointsInfo;
+        PointEnvelopes pointEnvelopes;
+        std::vector<float> pointLevels;
+        std::vector<juce::Point<float>> points;
+
+        // Used to skip the analysis, or the whole update, when it couldn't change the points.
+        bool hasNewSamples{ false };
+        bool envelopesSettled{ false };
+        bool pointsAtMinusInfinity{ false };
+
+        // Whether the last attempt to calculate the points found the engine idle, which may have been on the
+        // background thread.
+        std::atomic<bool> isIdling{ false };
 
         float nyquistFrequency{ 0.f };
         juce::NormalisableRange<float> frequencyRange;
@@ -214,6 +600,27 @@ namespace jump
         float maxHoldTime{ 0.f };
         float decayTime{ 0.f };
         int numPoints{ 0 };
+        float overlap{ 0.f };
+        AveragingMode averagingMode{ AveragingMode::none };
+        float averagingTime{ 0.f };
+        int maxFramesPerUpdate{ 0 };
+        BinAggregation binAggregation{ BinAggregation::max };
+        Smoothing smoothing{ Smoothing::none };
+
+        // The bins each bin is averaged over when smoothing. Fractional octaves cover the same bins at any sample rate,
+        // so every band shares these.
+        std::vector<juce::Range<int>> smoothingSpans;
+
+        PendingUpdates pendingUpdates;
+
+        // Used when analysing on a background thread. The lock guards everything above against being reconfigured
+        // from the message thread while the background thread is part-way through an analysis.
+        ExecutionMode executionMode{ ExecutionMode::messageThread };
+        juce::CriticalSection analysisLock;
+        AudioTransferManager<float> intake;
+        TripleBuffer<std::vector<juce::Point<float>>> pointFrames;
+        std::atomic<int> analysisInterval{ 1000 / 60 };
+        std::unique_ptr<juce::SharedResourcePointer<SharedAnalysisThread>> analysisThread;
 
         //==============================================================================================================
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumAnalyserEngine)
@@ -0,0 +1,756 @@
+#if JUCE_UNIT_TESTS
+
+#if JUMP_ENABLE_ALLOCATION_COUNTING
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    /** Returns the number of allocations made on the calling thread so far.
+
+        The module can't see every allocation made on its behalf by the standard library and JUCE without replacing
+        the global operator new, which only an executable may do. So this is only declared here: a test executable that
+        builds the module with JUMP_ENABLE_ALLOCATION_COUNTING=1 must define it, along with an operator new that counts
+        each allocation in a thread_local. Without that macro, the allocation tests aren't compiled.
+    */
+    std::size_t getNumAllocationsOnCurrentThread() noexcept;
+
+    //==================================================================================================================
+    /** Counts the allocations made on the current thread while an instance is in scope. */
+    class ScopedAllocationCounter
+    {
+    public:
+        //==============================================================================================================
+        ScopedAllocationCounter() noexcept
+            : numAllocationsAtStart{ getNumAllocationsOnCurrentThread() }
+        {
+        }
+
+        //==============================================================================================================
+        /** Returns the number of allocations made on this thread since this counter was created. */
+        int getNumAllocations() const noexcept
+        {
+            return static_cast<int>(getNumAllocationsOnCurrentThread() - numAllocationsAtStart);
+        }
+
+    private:
+        //==============================================================================================================
+        const std::size_t numAllocationsAtStart;
+
+        //==============================================================================================================
+        JUCE_DECLARE_NON_COPYABLE(ScopedAllocationCounter)
+    };
+} // namespace jump
+#endif
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    class SpectrumAnalyserEngineTests : public juce::UnitTest
+    {
+    public:
+        //==============================================================================================================
+        SpectrumAnalyserEngineTests()
+            : juce::UnitTest{ "SpectrumAnalyserEngine", "Engines" }
+        {
+        }
+
+        //==============================================================================================================
+        void runTest() override
+        {
+#if JUMP_ENABLE_ALLOCATION_COUNTING
+            beginTest("No allocations once warmed up");
+            {
+                using AveragingMode = SpectrumAnalyserEngine::AveragingMode;
+                using BinAggregation = SpectrumAnalyserEngine::BinAggregation;
+
+                for (const auto averagingMode : { AveragingMode::none, AveragingMode::exponential, AveragingMode::welch })
+                {
+                    for (const auto binAggregation : { BinAggregation::max, BinAggregation::meanPower })
+                    {
+                        SpectrumAnalyserEngine engine;
+                        engine.setAveragingMode(averagingMode);
+                        engine.setBinAggregation(binAggregation);
+                        engine.setNumResolutionBands(2);
+
+                        expectEquals(countSteadyStateAllocations(engine), 0);
+                    }
+                }
+
+                SpectrumAnalyserEngine smoothedEngine;
+                smoothedEngine.setSmoothing(SpectrumAnalyserEngine::Smoothing::thirdOctave);
+
+                expectEquals(countSteadyStateAllocations(smoothedEngine), 0);
+            }
+#endif
+
+            beginTest("Frames are a hop apart, set by the overlap and the window length");
+            {
+                SpectrumAnalyserEngine engine;
+                prepareForManualUpdates(engine);
+
+                engine.setOverlap(0.75f);
+                expectEquals(engine.getHopSize(), 256);
+
+                engine.setOverlap(0.f);
+                expectEquals(engine.getHopSize(), 1024);
+
+                engine.setOverlap(0.5f);
+                engine.setWindowLength(512);
+                expectEquals(engine.getHopSize(), 256);
+            }
+
+            beginTest("Every frame since the last update is combined by the averaging mode");
+            {
+                using AveragingMode = SpectrumAnalyserEngine::AveragingMode;
+
+                for (const auto averagingMode : { AveragingMode::welch,
+                                                  AveragingMode::exponential,
+                                                  AveragingMode::peakHold })
+                {
+                    SpectrumAnalyserEngine engine;
+                    prepareForManualUpdates(engine);
+                    engine.setOverlap(0.5f);
+                    engine.setAveragingMode(averagingMode);
+
+                    // Exactly five hops, so five frames are analysed and none are left over for the next update.
+                    static constexpr auto numFrames = 5;
+                    const auto noise = makeNoise(numFrames * engine.getHopSize());
+
+                    engine.addSamples(noise.data(), static_cast<int>(noise.size()));
+                    engine.update(juce::Time::getMillisecondCounter());
+
+                    const auto frames = transformFrames(engine, noise, numFrames);
+                    std::vector<float> expected(frames.front().size(), 0.f);
+
+                    // The default averaging time is 100ms.
+                    const auto hopSize = static_cast<float>(engine.getHopSize());
+                    const auto coefficient = std::exp(-hopSize * 1000.f / (48000.f * 100.f));
+
+                    for (std::size_t bin = 0; bin < expected.size(); bin++)
+                    {
+                        auto combined = 0.f;
+
+                        for (const auto& frame : frames)
+                        {
+                            const auto magnitude = frame[bin];
+
+                            if (averagingMode == AveragingMode::welch)
+                                combined += magnitude * magnitude / static_cast<float>(numFrames);
+                            else if (averagingMode == AveragingMode::exponential)
+                                combined = combined * coefficient + magnitude * magnitude * (1.f - coefficient);
+                            else
+                                combined = juce::jmax(combined, magnitude);
+                        }
+
+                        expected[bin] = averagingMode == AveragingMode::peakHold ? combined : std::sqrt(combined);
+                    }
+
+                    expectSpectrumMatches(engine.bands[0]->spectrum, expected);
+                }
+            }
+
+            beginTest("A tone's loudest point is at the tone's frequency with any bin aggregation");
+            {
+                using BinAggregation = SpectrumAnalyserEngine::BinAggregation;
+
+                for (const auto binAggregation : { BinAggregation::max,
+                                                   BinAggregation::meanPower,
+                                                   BinAggregation::interpolated })
+                {
+                    SpectrumAnalyserEngine engine;
+                    prepareForManualUpdates(engine);
+                    engine.setFFTOrder(12);
+                    engine.setBinAggregation(binAggregation);
+
+                    // Between two bins, so the bins either side of it have to be weighed up.
+                    const auto tone = makeSine(1000.f, 48000.0, 8192);
+                    engine.addSamples(tone.data(), static_cast<int>(tone.size()));
+                    engine.update(juce::Time::getMillisecondCounter());
+
+                    expectWithinOnePoint(engine, getLoudestFrequency(engine), 1000.f);
+                }
+            }
+
+            beginTest("The mean power of a point's bins is never louder than its loudest bin");
+            {
+                SpectrumAnalyserEngine maxEngine;
+                SpectrumAnalyserEngine meanPowerEngine;
+                meanPowerEngine.setBinAggregation(SpectrumAnalyserEngine::BinAggregation::meanPower);
+
+                const auto noise = makeNoise(8192);
+                const auto now = juce::Time::getMillisecondCounter();
+
+                for (auto* engine : { &maxEngine, &meanPowerEngine })
+                {
+                    prepareForManualUpdates(*engine);
+                    engine->addSamples(noise.data(), static_cast<int>(noise.size()));
+                    engine->update(now);
+                }
+
+                const auto& maxPoints = maxEngine.getLatestPoints();
+                const auto& meanPowerPoints = meanPowerEngine.getLatestPoints();
+                expectEquals(meanPowerPoints.size(), maxPoints.size());
+
+                auto numLouderPoints = 0;
+
+                // The points' Y values are measured down from the top of the Decibel range.
+                for (std::size_t i = 0; i < juce::jmin(maxPoints.size(), meanPowerPoints.size()); i++)
+                {
+                    if (meanPowerPoints[i].y < maxPoints[i].y - 1.0e-5f)
+                        numLouderPoints++;
+                }
+
+                expectEquals(numLouderPoints, 0);
+            }
+
+            beginTest("A window shorter than the FFT is zero-padded up to the FFT size");
+            {
+                SpectrumAnalyserEngine engine;
+                prepareForManualUpdates(engine);
+                engine.setFFTOrder(12);
+                engine.setWindowLength(1024);
+
+                expectEquals(engine.getWindowLength(), 1024);
+                expectEquals(engine.windowingTable->size(), std::size_t{ 1024 });
+                expectEquals(engine.bands[0]->spectrum.size(), std::size_t{ 2049 });
+
+                const auto noise = makeNoise(4096);
+                engine.addSamples(noise.data(), static_cast<int>(noise.size()));
+                engine.update(juce::Time::getMillisecondCounter());
+
+                // Only the most recent window's worth of samples are analysed.
+                expectSpectrumMatches(engine.bands[0]->spectrum, transformFrames(engine, noise, 1).front());
+
+                const auto tone = makeSine(1000.f, 48000.0, 4096);
+                engine.addSamples(tone.data(), static_cast<int>(tone.size()));
+                engine.setDecayTime(0.f);
+                engine.update(juce::Time::getMillisecondCounter() + 1000);
+
+                expectWithinOnePoint(engine, getLoudestFrequency(engine), 1000.f);
+            }
+
+            beginTest("The window length is limited to the FFT size");
+            {
+                SpectrumAnalyserEngine engine;
+                prepareForManualUpdates(engine);
+
+                engine.setWindowLength(4096);
+                expectEquals(engine.getWindowLength(), 1024);
+
+                engine.setWindowLength(0);
+                expectEquals(engine.getWindowLength(), 1024);
+            }
+
+            beginTest("Each resolution band halves the bandwidth and bin width of the band above it");
+            {
+                SpectrumAnalyserEngine engine;
+                prepareForManualUpdates(engine);
+                engine.setNumResolutionBands(3);
+
+                expectEquals(engine.getCrossoverFrequency(1), 6000.f);
+                expectEquals(engine.getCrossoverFrequency(2), 3000.f);
+                expectEquals(engine.getBandSampleRate(2), 12000.f);
+
+                // Each band gets half as many samples as the band above it.
+                const auto noise = makeNoise(2048);
+                engine.addSamples(noise.data(), static_cast<int>(noise.size()));
+
+                expectEquals(engine.bands[0]->numPendingSamples, std::size_t{ 2048 });
+                expectEquals(engine.bands[1]->numPendingSamples, std::size_t{ 1024 });
+                expectEquals(engine.bands[2]->numPendingSamples, std::size_t{ 512 });
+            }
+
+            beginTest("More resolution bands resolve a low tone more finely");
+            {
+                // Exactly on a bin of every band, so none of them are favoured by where the tone falls between bins.
+                static constexpr auto frequency = 93.75f;
+                std::array<float, 2> peakWidths{};
+
+                for (const auto numBands : { 1, 3 })
+                {
+                    SpectrumAnalyserEngine engine;
+                    prepareForManualUpdates(engine);
+                    engine.setNumResolutionBands(numBands);
+
+                    // Every point is kept at its own frequency, even where several points share a bin.
+                    engine.setBinAggregation(SpectrumAnalyserEngine::BinAggregation::interpolated);
+
+                    const auto tone = makeSine(frequency, 48000.0, 16384);
+                    engine.addSamples(tone.data(), static_cast<int>(tone.size()));
+                    engine.update(juce::Time::getMillisecondCounter());
+
+                    expectWithinOnePoint(engine, getLoudestFrequency(engine), frequency);
+
+                    // The range of frequencies within 12dB of the peak.
+                    const auto& frequencyRange = engine.getFrequencyRange();
+                    const auto peakLevel = getLoudestLevel(engine);
+                    auto lowest = frequencyRange.end;
+                    auto highest = frequencyRange.start;
+
+                    for (const auto& point : engine.getLatestPoints())
+                    {
+                        if (toDecibels(engine, point.y) >= peakLevel - 12.f)
+                        {
+                            const auto pointFrequency = math::logSpace(frequencyRange.start,
+                                                                       frequencyRange.end,
+                                                                       point.x);
+                            lowest = juce::jmin(lowest, pointFrequency);
+                            highest = juce::jmax(highest, pointFrequency);
+                        }
+                    }
+
+                    peakWidths[numBands == 1 ? 0 : 1] = highest - lowest;
+                }
+
+                expectLessThan(peakWidths[1], peakWidths[0] * 0.5f);
+            }
+
+            beginTest("Tones in the crossover between two bands are as loud as with a single band");
+            {
+                // Either side of, and on, both crossovers - each exactly on a bin of every band.
+                for (const auto frequency : { 2250.f, 3000.f, 4218.75f, 4500.f, 6000.f, 8015.625f })
+                {
+                    std::array<float, 2> levels{};
+
+                    for (const auto numBands : { 1, 3 })
+                    {
+                        SpectrumAnalyserEngine engine;
+                        prepareForManualUpdates(engine);
+                        engine.setNumResolutionBands(numBands);
+
+                        const auto tone = makeSine(frequency, 48000.0, 16384);
+                        engine.addSamples(tone.data(), static_cast<int>(tone.size()));
+                        engine.update(juce::Time::getMillisecondCounter());
+
+                        levels[numBands == 1 ? 0 : 1] = getLoudestLevel(engine);
+                    }
+
+                    expectWithinAbsoluteError(levels[1], levels[0], 0.5f, juce::String{ frequency } + "Hz");
+                }
+            }
+
+            beginTest("Smoothing averages the power over a fraction of an octave around each bin");
+            {
+                SpectrumAnalyserEngine engine;
+                engine.setFPS(0);
+                engine.setSampleRate(48000.0);
+                engine.setFFTOrder(10);
+                engine.setSmoothing(SpectrumAnalyserEngine::Smoothing::thirdOctave);
+
+                auto& band = *engine.bands[0];
+                auto& random = getRandom();
+
+                for (auto& magnitude : band.spectrum)
+                    magnitude = random.nextFloat();
+
+                engine.calculatePointsFromSpectra(juce::Time::getMillisecondCounter(), engine.points);
+
+                // Rather than the running sums the engine uses, the mean is found directly from every bin in range.
+                const auto halfWidth = std::pow(2.0, 0.5 / 3.0);
+                auto maxError = 0.0;
+
+                for (std::size_t bin = 0; bin < band.spectrum.size(); bin++)
+                {
+                    auto power = 0.0;
+                    auto numBinsInRange = 0;
+
+                    for (std::size_t other = 0; other < band.spectrum.size(); other++)
+                    {
+                        const auto isInRange = static_cast<double>(other) >= static_cast<double>(bin) / halfWidth
+                                            && static_cast<double>(other) <= static_cast<double>(bin) * halfWidth;
+
+                        if (isInRange)
+                        {
+                            power += static_cast<double>(band.spectrum[other]) * band.spectrum[other];
+                            numBinsInRange++;
+                        }
+                    }
+
+                    const auto expected = std::sqrt(power / numBinsInRange);
+                    maxError = juce::jmax(maxError, std::abs(band.smoothedSpectrum[bin] - expected));
+                }
+
+                expectLessThan(maxError, 1.0e-5);
+            }
+
+            beginTest("A decay time of 0 holds peaks and then drops them");
+            {
+                SpectrumAnalyserEngine::PointEnvelopes envelopes;
+                const auto decibelRange = juce::NormalisableRange<float>{ -100.f, 0.f };
+                envelopes.reset(1, decibelRange.start);
+
+                const auto levelAt = [&](float newLevel, juce::uint32 now) {
+                    envelopes.apply(&newLevel, now, 100.f, 10000.f, 0.f, decibelRange);
+                    return newLevel;
+                };
+
+                expectEquals(levelAt(-10.f, 1000), -10.f);
+                expectEquals(levelAt(-100.f, 1000), -10.f);
+                expectEquals(levelAt(-100.f, 1100), -10.f);
+                expectEquals(levelAt(-100.f, 1101), -100.f);
+            }
+
+            beginTest("Updates without new samples don't analyse the spectrum again");
+            {
+                SpectrumAnalyserEngine engine;
+                prepareForManualUpdates(engine);
+
+                const auto tone = makeSine(1000.f, 48000.0, 4800);
+                auto now = juce::Time::getMillisecondCounter();
+
+                engine.addSamples(tone.data(), static_cast<int>(tone.size()));
+                engine.update(now);
+
+                // Cleared behind the engine's back, so any further analysis would fill it in again.
+                auto& spectrum = engine.bands[0]->spectrum;
+                std::fill(spectrum.begin(), spectrum.end(), 0.f);
+
+                engine.update(now + 100);
+                expect(std::all_of(spectrum.begin(), spectrum.end(), [](float magnitude) {
+                    return magnitude == 0.f;
+                }));
+
+                engine.addSamples(tone.data(), static_cast<int>(tone.size()));
+                engine.update(now + 200);
+                expectGreaterThan(*std::max_element(spectrum.begin(), spectrum.end()), 0.f);
+            }
+
+            beginTest("Silence stops the renderers being called once it settles, until a setting changes");
+            {
+                SpectrumAnalyserEngine engine;
+                prepareForManualUpdates(engine);
+
+                RecordingRenderer renderer;
+                engine.addRenderer(&renderer);
+
+                auto now = juce::Time::getMillisecondCounter();
+                addSilenceUntilIdle(engine, now);
+
+                renderer.numCalls = 0;
+                addSilence(engine, now, 10);
+                expectEquals(renderer.numCalls, 0);
+
+                // A new Decibel range changes where the points are, so they have to be calculated again.
+                engine.setDecibelRange({ -80.f, 0.f });
+                expect(!engine.isIdle());
+
+                addSilence(engine, now, 1);
+                expectEquals(renderer.numCalls, 1);
+
+                const auto tone = makeSine(1000.f, 48000.0, 4800);
+                engine.addSamples(tone.data(), static_cast<int>(tone.size()));
+                engine.update(now);
+                expectEquals(renderer.numCalls, 2);
+
+                engine.removeRenderer(&renderer);
+            }
+
+            beginTest("Only renderers that need continuous updates are called while the engine idles");
+            {
+                SpectrumAnalyserEngine engine;
+                prepareForManualUpdates(engine);
+
+                RecordingRenderer renderer;
+                RecordingRenderer continuousRenderer{ true };
+                engine.addRenderer(&renderer);
+                engine.addRenderer(&continuousRenderer);
+
+                auto now = juce::Time::getMillisecondCounter();
+                addSilenceUntilIdle(engine, now);
+
+                renderer.numCalls = 0;
+                continuousRenderer.numCalls = 0;
+                addSilence(engine, now, 10);
+
+                expectEquals(renderer.numCalls, 0);
+                expectEquals(continuousRenderer.numCalls, 10);
+
+                engine.removeRenderer(&renderer);
+                engine.removeRenderer(&continuousRenderer);
+            }
+
+            beginTest("A spectrogram keeps scrolling while its source engine idles");
+            {
+                SpectrumAnalyserEngine engine;
+                prepareForManualUpdates(engine);
+
+                SpectrogramEngine spectrogram{ engine };
+                spectrogram.setNumFrames(100);
+
+                auto now = juce::Time::getMillisecondCounter();
+                addSilenceUntilIdle(engine, now);
+
+                const auto numFramesWhenIdle = spectrogram.getNumFramesAvailable();
+                addSilence(engine, now, 10);
+
+                expectEquals(spectrogram.getNumFramesAvailable(), numFramesWhenIdle + 10);
+            }
+
+            beginTest("Settings changed in a transaction give the same points as settings changed one at a time");
+            {
+                const auto changeSettings = [](SpectrumAnalyserEngine& engine) {
+                    engine.setFFTOrder(12);
+                    engine.setWindowLength(2048);
+                    engine.setNumResolutionBands(2);
+                    engine.setSmoothing(SpectrumAnalyserEngine::Smoothing::sixthOctave);
+                    engine.setNumPoints(128);
+                };
+
+                SpectrumAnalyserEngine separateChanges;
+                SpectrumAnalyserEngine transactionChanges;
+
+                for (auto* engine : { &separateChanges, &transactionChanges })
+                {
+                    engine->setFPS(0);
+                    engine->setSampleRate(48000.0);
+                    engine->setFFTOrder(10);
+                }
+
+                changeSettings(separateChanges);
+
+                {
+                    const auto transaction = transactionChanges.createTransaction();
+                    changeSettings(transactionChanges);
+                }
+
+                std::vector<float> noise(8192);
+
+                for (auto& sample : noise)
+                    sample = getRandom().nextFloat() * 2.f - 1.f;
+
+                const auto now = juce::Time::getMillisecondCounter();
+
+                for (auto* engine : { &separateChanges, &transactionChanges })
+                {
+                    engine->addSamples(noise.data(), static_cast<int>(noise.size()));
+                    engine->update(now);
+                }
+
+                expect(!transactionChanges.getLatestPoints().empty());
+                expect(separateChanges.getLatestPoints() == transactionChanges.getLatestPoints());
+            }
+        }
+
+    private:
+        //==============================================================================================================
+        /** Counts the number of times it's passed a set of points. */
+        struct RecordingRenderer : public SpectrumAnalyserRendererBase
+        {
+            explicit RecordingRenderer(bool shouldNeedContinuousUpdates = false)
+                : needsContinuous{ shouldNeedContinuousUpdates }
+            {
+            }
+
+            void newSpectrumAnalyserPointsAvailable(const SpectrumAnalyserEngine&,
+                                                    const std::vector<juce::Point<float>>&) override
+            {
+                numCalls++;
+            }
+
+            bool needsContinuousUpdates() const override
+            {
+                return needsContinuous;
+            }
+
+            const bool needsContinuous;
+            int numCalls{ 0 };
+        };
+
+        //==============================================================================================================
+        /** Returns the given number of samples of a sine wave. */
+        static std::vector<float> makeSine(float frequency, double sampleRate, int numSamples, float amplitude = 0.5f)
+        {
+            std::vector<float> samples(static_cast<std::size_t>(numSamples));
+            const auto increment = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+
+            for (std::size_t i = 0; i < samples.size(); i++)
+                samples[i] = amplitude * static_cast<float>(std::sin(increment * static_cast<double>(i)));
+
+            return samples;
+        }
+
+        /** Returns the given number of samples of white noise. */
+        std::vector<float> makeNoise(int numSamples)
+        {
+            std::vector<float> samples(static_cast<std::size_t>(numSamples));
+            auto& random = getRandom();
+
+            for (auto& sample : samples)
+                sample = random.nextFloat() * 2.f - 1.f;
+
+            return samples;
+        }
+
+        /** Returns the magnitudes of each of the most recent frames of the given samples, oldest first, as the engine
+            would calculate them if they were the only samples it had been given.
+        */
+        static std::vector<std::vector<float>> transformFrames(const SpectrumAnalyserEngine& engine,
+                                                               const std::vector<float>& samples,
+                                                               int numFrames)
+        {
+            const auto& window = *engine.windowingTable;
+            const auto numBins = static_cast<std::size_t>(engine.fft->getSize() / 2 + 1);
+            std::vector<std::vector<float>> frames;
+
+            for (auto frame = numFrames - 1; frame >= 0; frame--)
+            {
+                // The history is silent before the first sample.
+                const auto start = static_cast<int>(samples.size()) - static_cast<int>(window.size())
+                                 - frame * engine.getHopSize();
+
+                std::vector<float> fftData(static_cast<std::size_t>(engine.fft->getSize()) * 2, 0.f);
+
+                for (std::size_t i = 0; i < window.size(); i++)
+                {
+                    const auto index = start + static_cast<int>(i);
+
+                    if (index >= 0)
+                        fftData[i] = samples[static_cast<std::size_t>(index)] * window[i];
+                }
+
+                engine.fft->performFrequencyOnlyForwardTransform(fftData.data());
+                fftData.resize(numBins);
+                frames.push_back(std::move(fftData));
+            }
+
+            return frames;
+        }
+
+        /** Returns the frequency of the engine's loudest point. */
+        static float getLoudestFrequency(const SpectrumAnalyserEngine& engine)
+        {
+            const auto& points = engine.getLatestPoints();
+
+            // The points' Y values are measured down from the top of the Decibel range.
+            const auto loudest = std::min_element(points.begin(), points.end(), [](const auto& a, const auto& b) {
+                return a.y < b.y;
+            });
+
+            if (loudest == points.end())
+                return 0.f;
+
+            const auto& frequencyRange = engine.getFrequencyRange();
+            return math::logSpace(frequencyRange.start, frequencyRange.end, loudest->x);
+        }
+
+        /** Returns the level, in Decibels, of the given normalised Y value of one of the engine's points. */
+        static float toDecibels(const SpectrumAnalyserEngine& engine, float y)
+        {
+            // The points' Y values are measured down from the top of the Decibel range.
+            return engine.getDecibelRange().convertFrom0to1(1.f - y);
+        }
+
+        /** Returns the level, in Decibels, of the engine's loudest point. */
+        static float getLoudestLevel(const SpectrumAnalyserEngine& engine)
+        {
+            const auto& points = engine.getLatestPoints();
+            auto lowestY = 1.f;
+
+            for (const auto& point : points)
+                lowestY = juce::jmin(lowestY, point.y);
+
+            return toDecibels(engine, lowestY);
+        }
+
+        /** Expects the given frequency to be no further from the expected frequency than the spacing of the points. */
+        void expectWithinOnePoint(const SpectrumAnalyserEngine& engine, float frequency, float expectedFrequency)
+        {
+            const auto& frequencyRange = engine.getFrequencyRange();
+            const auto octavesPerPoint = std::log2(frequencyRange.end / frequencyRange.start)
+                                       / static_cast<float>(engine.numPoints - 1);
+
+            expectLessOrEqual(std::abs(std::log2(frequency / expectedFrequency)), octavesPerPoint,
+                              juce::String{ frequency } + "Hz");
+        }
+
+        void expectSpectrumMatches(const std::vector<float>& actual, const std::vector<float>& expected)
+        {
+            expectEquals(actual.size(), expected.size());
+
+            // The transforms round differently, so the magnitudes are compared relative to the loudest bin.
+            const auto peak = *std::max_element(expected.begin(), expected.end());
+            auto maxError = 0.f;
+
+            for (std::size_t bin = 0; bin < juce::jmin(actual.size(), expected.size()); bin++)
+                maxError = juce::jmax(maxError, std::abs(actual[bin] - expected[bin]));
+
+            expectLessThan(maxError, peak * 1.0e-4f);
+        }
+
+        /** Sets the engine up to be updated by the test rather than the scheduler. */
+        static void prepareForManualUpdates(SpectrumAnalyserEngine& engine)
+        {
+            engine.setFPS(0);
+            engine.setSampleRate(48000.0);
+            engine.setFFTOrder(10);
+        }
+
+        /** Adds a block of silence before each of the given number of updates, 100ms apart. */
+        static void addSilence(SpectrumAnalyserEngine& engine, juce::uint32& now, int numUpdates)
+        {
+            const std::vector<float> silence(4800, 0.f);
+
+            for (auto i = 0; i < numUpdates; i++)
+            {
+                engine.addSamples(silence.data(), static_cast<int>(silence.size()));
+                engine.update(now);
+                now += 100;
+            }
+        }
+
+        /** Adds silence until the points have decayed to the bottom of the Decibel range and the engine is idle. */
+        void addSilenceUntilIdle(SpectrumAnalyserEngine& engine, juce::uint32& now)
+        {
+            // Well beyond the default hold and decay times.
+            addSilence(engine, now, 20);
+
+            expect(engine.isIdle());
+        }
+
+#if JUMP_ENABLE_ALLOCATION_COUNTING
+        /** Feeds the engine blocks of noise as an audio callback would, updating it after each one, and returns the
+            number of allocations made by the updates once the engine has had a few updates to settle.
+        */
+        int countSteadyStateAllocations(SpectrumAnalyserEngine& engine)
+        {
+            static constexpr auto sampleRate = 48000.0;
+            static constexpr auto blockSize = 800;
+            static constexpr auto numWarmUpUpdates = 10;
+            static constexpr auto numCountedUpdates = 100;
+
+            // The updates are driven by the test rather than the scheduler.
+            engine.setFPS(0);
+            engine.setSampleRate(sampleRate);
+            engine.setFFTOrder(11);
+
+            std::vector<float> block(static_cast<std::size_t>(blockSize));
+            auto& random = getRandom();
+            auto now = juce::Time::getMillisecondCounter();
+
+            const auto update = [&] {
+                for (auto& sample : block)
+                    sample = random.nextFloat() * 2.f - 1.f;
+
+                engine.addSamples(block.data(), blockSize);
+                engine.update(now);
+                now += 16;
+            };
+
+            for (auto i = 0; i < numWarmUpUpdates; i++)
+                update();
+
+            const ScopedAllocationCounter allocationCounter;
+
+            for (auto i = 0; i < numCountedUpdates; i++)
+                update();
+
+            return allocationCounter.getNumAllocations();
+        }
+#endif
+    };
+
+    static SpectrumAnalyserEngineTests spectrumAnalyserEngineTests;
+} // namespace jump
+
+#endif
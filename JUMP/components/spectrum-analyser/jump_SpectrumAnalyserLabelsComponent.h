@@ -82,12 +82,28 @@ namespace jump
                 setHighlightedFrequenciesInternal(var_cast<std::vector<float>>(newValue));
         }
 
+        void transactionCommitted() override
+        {
+            if (std::exchange(areLevelLabelsPending, false))
+                updateLevelLabels();
+
+            if (std::exchange(areFrequencyLabelsPending, false))
+                updateFrequencyLabels();
+        }
+
         //==============================================================================================================
         void updateLevelLabels()
         {
             if (!lookAndFeel)
                 return;
 
+            // Creating labels is relatively expensive, so they're only recreated once a transaction is committed.
+            if (isInTransaction())
+            {
+                areLevelLabelsPending = true;
+                return;
+            }
+
             levelLabels.clear();
 
             for (const auto& level : levels)
@@ -127,6 +143,12 @@ namespace jump
             if (!lookAndFeel)
                 return;
 
+            if (isInTransaction())
+            {
+                areFrequencyLabelsPending = true;
+                return;
+            }
+
             frequencyLabels.clear();
 
             for (const auto& freq : frequencies)
@@ -188,6 +210,8 @@ namespace jump
         juce::OwnedArray<juce::Label> frequencyLabels;
         std::vector<float> levels;
         std::vector<float> frequencies;
+        bool areLevelLabelsPending{ false };
+        bool areFrequencyLabelsPending{ false };
         static inline const juce::Identifier levelPropertyId{ "level" };
         static inline const juce::Identifier frequencyPropertyId{ "frequency" };
 
@@ -4,9 +4,19 @@
 namespace jump
 {
     //==================================================================================================================
-    /** Implements the logic required for a basic circular buffer. */
+    /** Implements the logic required for a basic circular buffer.
+
+        By default the size of the buffer is set at runtime. If the size is known at compile time, it can instead be
+        given as the second template argument in which case the buffer is stored inline, aligned to a cache line, and
+        indexed using a bit mask rather than a comparison - see CircularBuffer<ValueType, fixedSize>.
+    */
+    template <typename ValueType, std::size_t fixedSize = 0>
+    class CircularBuffer;
+
+    //==================================================================================================================
+    /** A circular buffer whose size can be changed at runtime. */
     template <typename ValueType>
-    class CircularBuffer
+    class CircularBuffer<ValueType, 0>
     {
     public:
         //==============================================================================================================
@@ -20,7 +30,7 @@ namespace jump
 
         /** Constructs a buffer with every value set to initialValue. */
         CircularBuffer(int initialSize, ValueType initialValue = static_cast<ValueType>(0))
-            : data{ initialSize, initialValue }
+            : data(static_cast<std::size_t>(initialSize), initialValue)
         {
         }
 
@@ -40,7 +50,7 @@ namespace jump
         */
         CircularBuffer(CircularBuffer&& other)
             : data{ std::move(other.data) }
-            , writeIndex{ std::exchange(other.writeIndex) }
+            , writeIndex{ std::exchange(other.writeIndex, 0) }
         {
         }
 
@@ -60,6 +70,35 @@ namespace jump
                 writeIndex = 0;
         }
 
+        /** Writes a block of values to the container using at most two contiguous copies.
+
+            If the block is larger than the buffer, only the most recent values in the block are kept.
+
+            @param newValues    A pointer to the first value to write.
+            @param numValues    The number of values to write.
+        */
+        void write(const ValueType* newValues, std::size_t numValues)
+        {
+            if (data.empty())
+                return;
+
+            if (numValues > data.size())
+            {
+                newValues += numValues - data.size();
+                numValues = data.size();
+            }
+
+            const auto numBeforeWrap = juce::jmin(numValues, data.size() - writeIndex);
+
+            std::copy(newValues, newValues + numBeforeWrap, data.begin() + static_cast<std::ptrdiff_t>(writeIndex));
+            std::copy(newValues + numBeforeWrap, newValues + numValues, data.begin());
+
+            writeIndex += numValues;
+
+            if (writeIndex >= data.size())
+                writeIndex -= data.size();
+        }
+
         /** Returns an array containing N values.
 
             The data returned by this method will be sequential meaning the last element in the array will be the most
@@ -75,6 +114,54 @@ namespace jump
             return result;
         }
 
+        /** Copies the most recent values into the given destination without allocating.
+
+            As with read(), the values are sequential so the last value copied will be the most recent one added via
+            write().
+
+            @param destination  The array to copy the values to.
+            @param numValues    The number of values to copy - this should be no greater than the size of the buffer.
+        */
+        void read(ValueType* destination, std::size_t numValues) const
+        {
+            visit(numValues, [&destination](const ValueType* values, std::size_t numValuesInSegment) {
+                destination = std::copy(values, values + numValuesInSegment, destination);
+            });
+        }
+
+        /** Passes the most recent values to the given visitor without copying or allocating.
+
+            The visitor is called with a pointer to the values and the number of values, oldest first, once for each
+            contiguous segment of the buffer (so at most twice).
+
+            @param numValues    The number of values to visit - this should be no greater than the size of the buffer.
+            @param visitor      A callable with the signature void(const ValueType*, std::size_t).
+        */
+        template <typename Visitor>
+        void visit(std::size_t numValues, Visitor&& visitor) const
+        {
+            jassert(numValues <= data.size());
+
+            auto start = writeIndex + data.size() - numValues;
+
+            if (start >= data.size())
+                start -= data.size();
+
+            const auto numBeforeWrap = juce::jmin(numValues, data.size() - start);
+
+            if (numBeforeWrap > 0)
+                visitor(data.data() + start, numBeforeWrap);
+
+            if (numValues > numBeforeWrap)
+                visitor(data.data(), numValues - numBeforeWrap);
+        }
+
+        /** Returns the number of values held by the buffer. */
+        std::size_t size() const noexcept
+        {
+            return data.size();
+        }
+
         /** Resizes the internal data to the given size. */
         void resize(int newSize)
         {
@@ -98,7 +185,7 @@ namespace jump
         CircularBuffer& operator=(CircularBuffer&& other)
         {
             data = std::move(other.data);
-            writeIndex = std::exchange(other.writeIndex);
+            writeIndex = std::exchange(other.writeIndex, 0);
 
             return *this;
         }
@@ -121,4 +208,133 @@ namespace jump
         std::vector<ValueType> data;
         std::size_t writeIndex{ 0 };
     };
+
+    //==================================================================================================================
+    /** A circular buffer whose size is fixed at compile time.
+
+        The size must be a power of two, which allows every index to be wrapped with a single bit mask. The values are
+        stored inline, aligned to a cache line, and are initialised to zero.
+
+        The interface is the same as the runtime-sized CircularBuffer, minus resize().
+    */
+    template <typename ValueType, std::size_t fixedSize>
+    class CircularBuffer
+    {
+    public:
+        //==============================================================================================================
+        /** Creates a buffer with every value set to zero. */
+        CircularBuffer()
+        {
+        }
+
+        ~CircularBuffer()
+        {
+            static_assert(std::is_trivially_copyable<ValueType>::value,
+                          "'ValueType' for jump::CircularBuffer should be trivially copyable.");
+            static_assert(juce::isPowerOfTwo(fixedSize), "The size of a fixed-size jump::CircularBuffer must be a power of two.");
+        }
+
+        //==============================================================================================================
+        /** Writes the given value to the container. */
+        void write(ValueType newValue)
+        {
+            data[writeIndex] = newValue;
+            writeIndex = (writeIndex + 1) & mask;
+        }
+
+        /** Writes a block of values to the container using at most two memcpys.
+
+            If the block is larger than the buffer, only the most recent values in the block are kept.
+
+            @param newValues    A pointer to the first value to write.
+            @param numValues    The number of values to write.
+        */
+        void write(const ValueType* newValues, std::size_t numValues)
+        {
+            // An empty block may not come with a valid pointer, which memcpy mustn't be given even to copy nothing.
+            if (numValues == 0)
+                return;
+
+            if (numValues > fixedSize)
+            {
+                newValues += numValues - fixedSize;
+                numValues = fixedSize;
+            }
+
+            const auto numBeforeWrap = juce::jmin(numValues, fixedSize - writeIndex);
+
+            std::memcpy(data.data() + writeIndex, newValues, numBeforeWrap * sizeof(ValueType));
+            std::memcpy(data.data(), newValues + numBeforeWrap, (numValues - numBeforeWrap) * sizeof(ValueType));
+
+            writeIndex = (writeIndex + numValues) & mask;
+        }
+
+        /** Returns an array containing N values.
+
+            The data returned by this method will be sequential meaning the last element in the array will be the most
+            recent one added via write().
+        */
+        std::vector<ValueType> read() const
+        {
+            std::vector<ValueType> result(fixedSize);
+            read(result.data(), fixedSize);
+
+            return result;
+        }
+
+        /** Copies the most recent values into the given destination without allocating.
+
+            @param destination  The array to copy the values to.
+            @param numValues    The number of values to copy - this should be no greater than the size of the buffer.
+        */
+        void read(ValueType* destination, std::size_t numValues) const
+        {
+            visit(numValues, [&destination](const ValueType* values, std::size_t numValuesInSegment) {
+                std::memcpy(destination, values, numValuesInSegment * sizeof(ValueType));
+                destination += numValuesInSegment;
+            });
+        }
+
+        /** Passes the most recent values to the given visitor without copying or allocating.
+
+            @param numValues    The number of values to visit - this should be no greater than the size of the buffer.
+            @param visitor      A callable with the signature void(const ValueType*, std::size_t).
+        */
+        template <typename Visitor>
+        void visit(std::size_t numValues, Visitor&& visitor) const
+        {
+            jassert(numValues <= fixedSize);
+
+            const auto start = (writeIndex - numValues) & mask;
+            const auto numBeforeWrap = juce::jmin(numValues, fixedSize - start);
+
+            if (numBeforeWrap > 0)
+                visitor(data.data() + start, numBeforeWrap);
+
+            if (numValues > numBeforeWrap)
+                visitor(data.data(), numValues - numBeforeWrap);
+        }
+
+        /** Returns the number of values held by the buffer. */
+        constexpr std::size_t size() const noexcept
+        {
+            return fixedSize;
+        }
+
+        //==============================================================================================================
+        /** Returns an element from the buffer in its 'true' position meaning an index of [N - 1] will return the most
+            recent value added via write().
+        */
+        ValueType operator[](std::size_t index) const
+        {
+            return data[(index + writeIndex) & mask];
+        }
+
+    private:
+        //==============================================================================================================
+        static constexpr std::size_t mask = fixedSize - 1;
+
+        alignas(cacheLineSize) std::array<ValueType, fixedSize> data{};
+        std::size_t writeIndex{ 0 };
+    };
 } // namespace jump
@@ -0,0 +1,99 @@
+#if JUCE_UNIT_TESTS
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    class CircularBufferTests : public juce::UnitTest
+    {
+    public:
+        //==============================================================================================================
+        CircularBufferTests()
+            : juce::UnitTest{ "CircularBuffer", "Containers" }
+        {
+        }
+
+        //==============================================================================================================
+        void runTest() override
+        {
+            beginTest("A fixed-size buffer starts out filled with zeros");
+            {
+                const CircularBuffer<int, 8> buffer;
+
+                expectEquals(static_cast<int>(buffer.size()), 8);
+                expect(buffer.read() == std::vector<int>(8, 0));
+            }
+
+            beginTest("Single writes to a fixed-size buffer wrap around its end");
+            {
+                CircularBuffer<int, 8> buffer;
+
+                for (auto value = 1; value <= 11; value++)
+                    buffer.write(value);
+
+                expect(buffer.read() == std::vector<int>{ 4, 5, 6, 7, 8, 9, 10, 11 });
+                expectEquals(buffer[7], 11);
+                expectEquals(buffer[0], 4);
+            }
+
+            beginTest("Block writes to a fixed-size buffer match the same values written one at a time");
+            {
+                CircularBuffer<int, 8> blockWrites;
+                CircularBuffer<int, 8> singleWrites;
+                auto nextValue = 1;
+
+                // Block sizes that land on, before, and past the end of the buffer, as well as larger than it.
+                for (const auto blockSize : { 3, 5, 8, 1, 7, 20, 0, 6 })
+                {
+                    std::vector<int> block(static_cast<std::size_t>(blockSize));
+
+                    for (auto& value : block)
+                    {
+                        value = nextValue++;
+                        singleWrites.write(value);
+                    }
+
+                    blockWrites.write(block.data(), block.size());
+
+                    expect(blockWrites.read() == singleWrites.read());
+                }
+            }
+
+            beginTest("A block larger than a fixed-size buffer only keeps its most recent values");
+            {
+                CircularBuffer<int, 4> buffer;
+                buffer.write(1);
+
+                const std::vector<int> block{ 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+                buffer.write(block.data(), block.size());
+
+                expect(buffer.read() == std::vector<int>{ 7, 8, 9, 10 });
+            }
+
+            beginTest("Partial reads from a fixed-size buffer return the most recent values across the wrap");
+            {
+                CircularBuffer<int, 8> buffer;
+
+                for (auto value = 1; value <= 10; value++)
+                    buffer.write(value);
+
+                std::vector<int> destination(5);
+                buffer.read(destination.data(), destination.size());
+
+                expect(destination == std::vector<int>{ 6, 7, 8, 9, 10 });
+
+                auto numSegments = 0;
+                buffer.visit(5, [&numSegments](const int*, std::size_t) {
+                    numSegments++;
+                });
+
+                // The write index is 2, so the five most recent values are split over the end of the buffer.
+                expectEquals(numSegments, 2);
+            }
+        }
+    };
+
+    static CircularBufferTests circularBufferTests;
+} // namespace jump
+
+#endif
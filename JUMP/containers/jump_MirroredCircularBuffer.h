@@ -0,0 +1,130 @@
+#pragma once
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    /** A circular buffer that can always return its most recent values as a single contiguous array.
+
+        Unlike CircularBuffer, reading from this container never requires the values to be copied or rearranged - the
+        pointer returned by getMostRecent() can be handed straight to something like an FFT windowing function.
+
+        This is achieved using a MirroredMemoryBlock, so on Linux the backing pages are mapped twice back to back and
+        every value is only written once. On other platforms every value is written twice, to both halves of a block
+        that's double the size of the buffer.
+
+        The size of the buffer is always a power of two and, where mirroring is available, at least one page of memory.
+    */
+    template <typename ValueType>
+    class MirroredCircularBuffer
+    {
+    public:
+        //==============================================================================================================
+        /** Creates an empty buffer - resize() must be called before the buffer can be used. */
+        MirroredCircularBuffer() = default;
+
+        /** Creates a buffer able to hold at least the given number of values, all initialised to zero. */
+        explicit MirroredCircularBuffer(std::size_t minimumSize)
+        {
+            resize(minimumSize);
+        }
+
+        ~MirroredCircularBuffer()
+        {
+            static_assert(std::is_trivially_copyable<ValueType>::value,
+                          "'ValueType' for jump::MirroredCircularBuffer must be trivially copyable.");
+        }
+
+        //==============================================================================================================
+        /** Writes the given value to the buffer. */
+        void write(ValueType newValue)
+        {
+            values[writeIndex] = newValue;
+
+            if (!memory.isMirrored())
+                values[writeIndex + bufferSize] = newValue;
+
+            writeIndex = (writeIndex + 1) & (bufferSize - 1);
+        }
+
+        /** Writes a block of values to the buffer.
+
+            If the block is larger than the buffer, only the most recent values in the block are kept.
+
+            @param newValues    A pointer to the first value to write.
+            @param numValues    The number of values to write.
+        */
+        void write(const ValueType* newValues, std::size_t numValues)
+        {
+            if (numValues > bufferSize)
+            {
+                newValues += numValues - bufferSize;
+                numValues = bufferSize;
+            }
+
+            if (memory.isMirrored())
+            {
+                // The second half aliases the first so the block can always be written in one go.
+                std::memcpy(values + writeIndex, newValues, numValues * sizeof(ValueType));
+            }
+            else
+            {
+                const auto numBeforeWrap = juce::jmin(numValues, bufferSize - writeIndex);
+                const auto numAfterWrap = numValues - numBeforeWrap;
+
+                std::memcpy(values + writeIndex, newValues, numBeforeWrap * sizeof(ValueType));
+                std::memcpy(values + writeIndex + bufferSize, newValues, numBeforeWrap * sizeof(ValueType));
+                std::memcpy(values, newValues + numBeforeWrap, numAfterWrap * sizeof(ValueType));
+                std::memcpy(values + bufferSize, newValues + numBeforeWrap, numAfterWrap * sizeof(ValueType));
+            }
+
+            writeIndex = (writeIndex + numValues) & (bufferSize - 1);
+        }
+
+        /** Returns a pointer to the given number of most recent values, oldest first.
+
+            The pointer is valid until the next call to write() or resize().
+
+            @param numValues    The number of values to return - this should be no greater than the size of the buffer.
+        */
+        const ValueType* getMostRecent(std::size_t numValues) const noexcept
+        {
+            jassert(numValues <= bufferSize);
+
+            return values + writeIndex + bufferSize - numValues;
+        }
+
+        /** Returns the number of values held by the buffer. */
+        std::size_t size() const noexcept
+        {
+            return bufferSize;
+        }
+
+        /** Resizes the buffer so it's able to hold at least the given number of values.
+
+            This reallocates and zeroes the buffer, even if its size doesn't change.
+        */
+        void resize(std::size_t minimumSize)
+        {
+            auto newSize = static_cast<std::size_t>(juce::nextPowerOfTwo(static_cast<int>(juce::jmax(minimumSize, std::size_t{ 1 }))));
+
+            if (MirroredMemoryBlock::getGranularity() % sizeof(ValueType) == 0)
+                newSize = juce::jmax(newSize, MirroredMemoryBlock::getGranularity() / sizeof(ValueType));
+
+            memory.allocate(newSize * sizeof(ValueType));
+            values = static_cast<ValueType*>(memory.getData());
+            bufferSize = newSize;
+            writeIndex = 0;
+        }
+
+    private:
+        //==============================================================================================================
+        MirroredMemoryBlock memory;
+        ValueType* values{ nullptr };
+        std::size_t bufferSize{ 0 };
+        std::size_t writeIndex{ 0 };
+
+        //==============================================================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MirroredCircularBuffer)
+    };
+} // namespace jump
@@ -0,0 +1,126 @@
+#include "jump_MirroredMemoryBlock.h"
+
+#if JUCE_LINUX
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    MirroredMemoryBlock::~MirroredMemoryBlock()
+    {
+        free();
+    }
+
+    //==================================================================================================================
+    void MirroredMemoryBlock::allocate(std::size_t numBytes)
+    {
+        free();
+
+        if (numBytes == 0)
+            return;
+
+        if (numBytes % getGranularity() == 0 && allocateMirrored(numBytes))
+            return;
+
+        fallback.allocate(numBytes * 2, true);
+        data = fallback.get();
+        size = numBytes;
+        mirrored = false;
+    }
+
+    void MirroredMemoryBlock::free()
+    {
+#if JUCE_LINUX
+        if (mirrored)
+            munmap(data, size * 2);
+#endif
+
+        fallback.free();
+        data = nullptr;
+        size = 0;
+        mirrored = false;
+    }
+
+    //==================================================================================================================
+    void* MirroredMemoryBlock::getData() const noexcept
+    {
+        return data;
+    }
+
+    std::size_t MirroredMemoryBlock::getSize() const noexcept
+    {
+        return size;
+    }
+
+    bool MirroredMemoryBlock::isMirrored() const noexcept
+    {
+        return mirrored;
+    }
+
+    //==================================================================================================================
+    std::size_t MirroredMemoryBlock::getGranularity() noexcept
+    {
+#if JUCE_LINUX
+        static const auto pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        return pageSize;
+#else
+        return 4096;
+#endif
+    }
+
+    //==================================================================================================================
+    bool MirroredMemoryBlock::allocateMirrored(std::size_t numBytes)
+    {
+#if JUCE_LINUX
+        const auto fd = memfd_create("jump::MirroredMemoryBlock", MFD_CLOEXEC);
+
+        if (fd < 0)
+            return false;
+
+        if (ftruncate(fd, static_cast<off_t>(numBytes)) != 0)
+        {
+            close(fd);
+            return false;
+        }
+
+        // Reserve enough address space for both halves, then map the file over each half in turn.
+        auto* reserved = mmap(nullptr, numBytes * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (reserved == MAP_FAILED)
+        {
+            close(fd);
+            return false;
+        }
+
+        auto* firstHalf = static_cast<char*>(reserved);
+        auto* secondHalf = firstHalf + numBytes;
+
+        const auto mapHalf = [fd, numBytes](char* address) {
+            return mmap(address, numBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == address;
+        };
+
+        const auto success = mapHalf(firstHalf) && mapHalf(secondHalf);
+
+        // The mappings keep the memory alive so the file descriptor is no longer needed.
+        close(fd);
+
+        if (!success)
+        {
+            munmap(reserved, numBytes * 2);
+            return false;
+        }
+
+        data = reserved;
+        size = numBytes;
+        mirrored = true;
+
+        return true;
+#else
+        juce::ignoreUnused(numBytes);
+        return false;
+#endif
+    }
+} // namespace jump
@@ -0,0 +1,66 @@
+#pragma once
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    /** A block of memory that's addressable twice over, back to back.
+
+        Where the platform supports it (currently Linux) the same physical pages are mapped twice in a row so that
+        writing to byte i also writes to byte i + getSize(). Elsewhere, or if the mapping fails, a plain block of twice
+        the size is allocated instead and it's up to the owner to write everything to both halves - see isMirrored().
+
+        Either way getData() points to getSize() * 2 usable bytes, which is what allows a circular buffer built on top
+        of this to hand out a single contiguous pointer to its most recent values.
+    */
+    class MirroredMemoryBlock
+    {
+    public:
+        //==============================================================================================================
+        /** Creates an empty block. */
+        MirroredMemoryBlock() = default;
+
+        /** Releases the block. */
+        ~MirroredMemoryBlock();
+
+        //==============================================================================================================
+        /** Releases any existing memory and allocates a new, zeroed block.
+
+            @param numBytes The size of each of the two halves of the block. The block will only be mirrored if this is
+                            a multiple of getGranularity().
+        */
+        void allocate(std::size_t numBytes);
+
+        /** Releases the memory held by this block. */
+        void free();
+
+        //==============================================================================================================
+        /** Returns a pointer to the start of the block, which is getSize() * 2 bytes long. */
+        void* getData() const noexcept;
+
+        /** Returns the size of one of the two halves of the block. */
+        std::size_t getSize() const noexcept;
+
+        /** Returns true if the two halves of the block are mapped to the same memory. If not, the owner is responsible
+            for keeping both halves in sync.
+        */
+        bool isMirrored() const noexcept;
+
+        //==============================================================================================================
+        /** Returns the size, in bytes, that a block must be a multiple of in order to be mirrored. */
+        static std::size_t getGranularity() noexcept;
+
+    private:
+        //==============================================================================================================
+        bool allocateMirrored(std::size_t numBytes);
+
+        //==============================================================================================================
+        void* data{ nullptr };
+        std::size_t size{ 0 };
+        bool mirrored{ false };
+        juce::HeapBlock<char> fallback;
+
+        //==============================================================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MirroredMemoryBlock)
+    };
+} // namespace jump
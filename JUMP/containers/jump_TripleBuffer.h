@@ -0,0 +1,139 @@
+#pragma once
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    /** Publishes whole frames of data (e.g. the points of a spectrum or a struct of meter values) from one thread to
+        another, where the reader is only ever interested in the newest complete frame.
+
+        The container holds three frames: one being written to, one being read from, and a spare holding the most
+        recently published frame. Publishing and acquiring a frame only swaps indices - the frames themselves are never
+        copied - so neither the writer nor the reader ever blocks, waits, or copies any data. Frames the reader didn't
+        get around to reading are simply replaced by newer ones.
+
+        Because the frames are reused rather than recreated, frames that own memory (such as a std::vector) should be
+        sized up-front (either through the constructor or using forEachFrame()) so that neither thread has to allocate
+        once they're running.
+
+        Exactly one thread may write to the container and exactly one thread may read from it.
+
+        @code
+        // Writer:
+        auto& frame = frames.getWriteBuffer();
+        fillFrame(frame);
+        frames.publish();
+
+        // Reader:
+        if (frames.acquireLatest())
+            draw(frames.getReadBuffer());
+        @endcode
+
+        @tparam FrameType   The type of frame to publish.
+    */
+    template <typename FrameType>
+    class TripleBuffer
+    {
+    public:
+        //==============================================================================================================
+        /** Creates a container with all three frames initialised to the given value. */
+        explicit TripleBuffer(const FrameType& initialFrame = FrameType{})
+            : frames{ initialFrame, initialFrame, initialFrame }
+        {
+        }
+
+        //==============================================================================================================
+        /** Returns the frame the writer should write its next frame to.
+
+            The frame still contains whatever was last written to it, possibly several frames ago. The reference is
+            valid until the next call to publish().
+
+            This should only ever be called from the writer thread.
+        */
+        FrameType& getWriteBuffer() noexcept
+        {
+            return frames[writeIndex];
+        }
+
+        /** Publishes the frame returned by getWriteBuffer(), making it the newest frame available to the reader.
+
+            This should only ever be called from the writer thread.
+        */
+        void publish() noexcept
+        {
+            const auto previousSpare = spare.value.exchange(static_cast<int>(writeIndex) | newFrameFlag,
+                                                            std::memory_order_acq_rel);
+            writeIndex = static_cast<std::size_t>(previousSpare & indexMask);
+        }
+
+        //==============================================================================================================
+        /** Makes the newest published frame available through getReadBuffer(), if one has been published since this
+            was last called.
+
+            This should only ever be called from the reader thread.
+
+            @returns    True if a new frame was acquired, false if the read buffer still holds the same frame as before.
+        */
+        bool acquireLatest() noexcept
+        {
+            if ((spare.value.load(std::memory_order_relaxed) & newFrameFlag) == 0)
+                return false;
+
+            const auto previousSpare = spare.value.exchange(static_cast<int>(readIndex), std::memory_order_acq_rel);
+            readIndex = static_cast<std::size_t>(previousSpare & indexMask);
+
+            return true;
+        }
+
+        /** Returns the frame most recently acquired by acquireLatest().
+
+            The reference is valid until the next call to acquireLatest().
+
+            This should only ever be called from the reader thread.
+        */
+        const FrameType& getReadBuffer() const noexcept
+        {
+            return frames[readIndex];
+        }
+
+        /** Returns true if a frame has been published that hasn't yet been acquired by the reader. */
+        bool hasNewFrame() const noexcept
+        {
+            return (spare.value.load(std::memory_order_relaxed) & newFrameFlag) != 0;
+        }
+
+        //==============================================================================================================
+        /** Calls the given function with each of the three frames, e.g. to resize them.
+
+            This is not thread safe so should only be used while neither thread is using the container.
+
+            @param function     A callable with the signature void(FrameType&).
+        */
+        template <typename Function>
+        void forEachFrame(Function&& function)
+        {
+            for (auto& frame : frames)
+                function(frame);
+        }
+
+    private:
+        //==============================================================================================================
+        static constexpr int indexMask = 0b011;
+        static constexpr int newFrameFlag = 0b100;
+
+        struct alignas(cacheLineSize) PaddedIndex
+        {
+            std::atomic<int> value{ 2 };
+        };
+
+        //==============================================================================================================
+        std::array<FrameType, 3> frames;
+
+        alignas(cacheLineSize) std::size_t writeIndex{ 0 };
+        PaddedIndex spare;
+        alignas(cacheLineSize) std::size_t readIndex{ 1 };
+
+        //==============================================================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TripleBuffer)
+    };
+} // namespace jump
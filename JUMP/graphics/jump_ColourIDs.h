@@ -20,6 +20,12 @@ namespace jump
         spectrumAnalyserGridlinesColourId,
         spectrumAnalyserSafeColourId,
         spectrumAnalyserWarningColourId,
-        spectrumAnalyserDangerColourId
+        spectrumAnalyserDangerColourId,
+
+        spectrogramBackgroundColourId,
+        spectrogramBorderColourId,
+        spectrogramSafeColourId,
+        spectrogramWarningColourId,
+        spectrogramDangerColourId
     };
 } // namespace jump
@@ -480,6 +480,35 @@ namespace jump::lookAndFeelImplementations
         return label;
     }
 
+    //==================================================================================================================
+    void SpectrogramLookAndFeel::drawBackground(juce::Graphics& g, const Spectrogram& spectrogram) const noexcept
+    {
+        const auto bounds = spectrogram.getLocalBounds().toFloat().reduced(constants::widgetBorderThickness / 2.f);
+        const auto path = createRoundedRectanglePath(bounds, constants::widgetCornerRadius);
+
+        g.setColour(spectrogram.findColour(ColourIds::spectrogramBackgroundColourId));
+        g.fillPath(path);
+
+        g.setColour(spectrogram.findColour(ColourIds::spectrogramBorderColourId));
+        g.strokePath(path, juce::PathStrokeType{ constants::widgetBorderThickness });
+    }
+
+    juce::Colour SpectrogramLookAndFeel::getSpectrogramColour(const Spectrogram& spectrogram,
+                                                              float normalisedLevel) const noexcept
+    {
+        const auto& decibelRange = spectrogram.getEngine().getSourceEngine().getDecibelRange();
+        const auto normalisedWarningLevel = static_cast<double>(decibelRange.convertTo0to1(constants::warningLevelDecibels));
+
+        // Quiet levels fade into the background so the spectrogram isn't swamped by the noise floor.
+        juce::ColourGradient gradient;
+        gradient.addColour(0.0, spectrogram.findColour(spectrogramBackgroundColourId));
+        gradient.addColour(normalisedWarningLevel / 2.0, spectrogram.findColour(spectrogramSafeColourId));
+        gradient.addColour(normalisedWarningLevel, spectrogram.findColour(spectrogramWarningColourId));
+        gradient.addColour(1.0, spectrogram.findColour(spectrogramDangerColourId));
+
+        return gradient.getColourAtPosition(static_cast<double>(normalisedLevel));
+    }
+
     //==================================================================================================================
     void SvgLookAndFeel::drawSvgComponent(juce::Graphics& g, const SvgComponent& component) const
     {
@@ -521,6 +550,12 @@ namespace jump
         setColour(spectrumAnalyserWarningColourId, scheme.warning);
         setColour(spectrumAnalyserDangerColourId, scheme.danger);
 
+        setColour(spectrogramBackgroundColourId, scheme.widgetBackground);
+        setColour(spectrogramBorderColourId, scheme.widgetBorder);
+        setColour(spectrogramSafeColourId, scheme.safe);
+        setColour(spectrogramWarningColourId, scheme.warning);
+        setColour(spectrogramDangerColourId, scheme.danger);
+
         setColour(juce::ResizableWindow::backgroundColourId, scheme.windowBackground);
         setColour(juce::Label::textColourId, scheme.textNormal);
     }
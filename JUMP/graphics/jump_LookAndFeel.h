@@ -43,6 +43,15 @@ namespace jump
                                                                  float frequency) const noexcept override final;
         };
 
+        //==============================================================================================================
+        class SpectrogramLookAndFeel : public Spectrogram::LookAndFeelMethods
+        {
+            // Spectrogram
+            void drawBackground(juce::Graphics& g, const Spectrogram& spectrogram) const noexcept override final;
+            juce::Colour getSpectrogramColour(const Spectrogram& spectrogram,
+                                              float normalisedLevel) const noexcept override final;
+        };
+
         //==============================================================================================================
         class SvgLookAndFeel : public SvgComponent::LookAndFeelMethods
         {
@@ -56,6 +65,7 @@ namespace jump
         : public juce::LookAndFeel_V4
         , public lookAndFeelImplementations::LevelMeterLookAndFeel
         , public lookAndFeelImplementations::SpectrumAnalyserLookAndFeel
+        , public lookAndFeelImplementations::SpectrogramLookAndFeel
         , public lookAndFeelImplementations::SvgLookAndFeel
     {
         //==============================================================================================================
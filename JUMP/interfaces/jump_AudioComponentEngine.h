@@ -8,22 +8,38 @@ namespace jump
 
         The derived engines should be used to implement the logic for a specific type of audio visualiser such as a
         spectrum analyser or level meter.
+
+        Engines are updated by the shared EngineScheduler at 60 FPS by default.
     */
     template <typename RendererType>
     class AudioComponentEngine
         : protected StatefulObject
-        , private juce::Timer
+        , private EngineScheduler::Client
     {
     public:
         //==============================================================================================================
-        AudioComponentEngine() = default;
+        AudioComponentEngine()
+        {
+            scheduler->addClient(*this, fps, priority);
+        }
 
         AudioComponentEngine(const juce::Identifier& uniqueID, StatefulObject* parentState)
             : StatefulObject{ uniqueID, parentState }
         {
+            scheduler->addClient(*this, fps, priority);
+        }
+
+        virtual ~AudioComponentEngine() override
+        {
+            scheduler->removeClient(*this);
         }
 
-        virtual ~AudioComponentEngine() override = default;
+        //==============================================================================================================
+        /** Opens a transaction so that several settings can be changed while only rebuilding the engine once.
+
+            @see StatefulObject::ScopedTransaction
+        */
+        using StatefulObject::createTransaction;
 
         //==============================================================================================================
         /** Writes a stream of samples to the sample buffer.
@@ -31,9 +47,25 @@ namespace jump
             This should be called regularly with sequential blocks of audio samples, preferably from an
             AudioTransportManager to ensure thread safety.
 
+            By default this forwards the samples to addSamples(const float*, int), so derived engines only need to
+            override that overload.
+
             @param samples  The block of samples to write to the buffer.
         */
-        virtual void addSamples(const std::vector<float>& samples) = 0;
+        virtual void addSamples(const std::vector<float>& samples)
+        {
+            addSamples(samples.data(), static_cast<int>(samples.size()));
+        }
+
+        /** Writes a stream of samples to the sample buffer without requiring them to be held in a vector.
+
+            This pairs with the visitor-based read() methods of AudioTransferManager and AudioTransferRingBuffer so
+            samples can be passed from the audio thread to an engine without any allocations.
+
+            @param samples      A pointer to the first sample to write.
+            @param numSamples   The number of samples to write.
+        */
+        virtual void addSamples(const float* samples, int numSamples) = 0;
 
         /** Registers a renderer that will receive callbacks when new points are calculated by this engine.
 
@@ -53,39 +85,71 @@ namespace jump
             renderers.remove(rendererToRemove);
         }
 
+        /** Returns true if any of this engine's renderers are currently visible.
+
+            @see RendererType::isRendererVisible()
+        */
+        bool hasVisibleRenderers() const override
+        {
+            auto isVisible = false;
+
+            renderers.call([&isVisible](RendererType& renderer) {
+                isVisible = isVisible || renderer.isRendererVisible();
+            });
+
+            return isVisible;
+        }
+
         //==============================================================================================================
+        /** Changes the rate at which this engine is updated.
+
+            An FPS of 0 stops the engine from being updated at all.
+        */
         void setFPS(int newFPS)
         {
-            stopTimer();
-            startTimerHz(newFPS);
+            fps = juce::jmax(newFPS, 0);
+            scheduler->addClient(*this, fps, priority);
+        }
+
+        /** Changes how important it is that this engine is updated at its full rate.
+
+            When the EngineScheduler runs over budget, engines whose renderers are hidden are slowed down first,
+            followed by those with the lowest priority. The default is EngineScheduler::Priority::normal.
+        */
+        void setUpdatePriority(EngineScheduler::Priority newPriority)
+        {
+            priority = newPriority;
+            scheduler->setPriority(*this, priority);
         }
 
     protected:
         //==============================================================================================================
         virtual void update(juce::uint32 now) = 0;
 
+        /** Returns the interval, in milliseconds, between calls to update(), or 0 if the engine isn't being updated.
+
+            This follows the rate the EngineScheduler is actually updating the engine at, which may be slower than the
+            engine's FPS while the scheduler is over budget.
+        */
+        int getUpdateInterval() const noexcept
+        {
+            return scheduler->getUpdateInterval(*this);
+        }
+
         //==============================================================================================================
         mutable juce::ListenerList<RendererType> renderers;
 
     private:
         //==============================================================================================================
-        struct StartTimerOnCreation
-        {
-            StartTimerOnCreation(juce::Timer& timerToStart, int timerHz)
-            {
-                timerToStart.startTimerHz(timerHz);
-            }
-        };
-
-        //==============================================================================================================
-        void timerCallback() override
+        void scheduledUpdate(juce::uint32 now) override
         {
-            const auto now = juce::Time::getMillisecondCounter();
             update(now);
         }
 
         //==============================================================================================================
         CircularBuffer<float> buffer;
-        StartTimerOnCreation timerStarter{ *this, 60 };
+        juce::SharedResourcePointer<EngineScheduler> scheduler;
+        int fps{ 60 };
+        EngineScheduler::Priority priority{ EngineScheduler::Priority::normal };
     };
 } // namespace jump
@@ -7,6 +7,46 @@ namespace jump
     class StatefulObject : private juce::ValueTree::Listener
     {
     public:
+        //==============================================================================================================
+        /** Batches a set of property changes so the work they cause is only done once.
+
+            While a transaction is open, property changes are still applied and propertyChanged() is still called on
+            the object and its children as usual, but isInTransaction() returns true so derived classes can mark any
+            expensive rebuilding as pending rather than doing it straight away. When the outermost transaction ends,
+            transactionCommitted() is called on the object and each of its children so the pending work is done once.
+
+            @code
+            {
+                const auto transaction = engine.createTransaction();
+
+                engine.setSampleRate(48000.0);
+                engine.setFFTOrder(13);
+                engine.setNumPoints(512);
+            } // The engine only rebuilds itself once, here.
+            @endcode
+        */
+        class ScopedTransaction
+        {
+        public:
+            explicit ScopedTransaction(StatefulObject& objectToUpdate)
+                : object{ objectToUpdate }
+            {
+                object.transactionDepth++;
+            }
+
+            ~ScopedTransaction()
+            {
+                // If a parent is also in a transaction, this object is committed along with it.
+                if (--object.transactionDepth == 0 && !object.isInTransaction())
+                    object.commitTransactionRecursively();
+            }
+
+        private:
+            StatefulObject& object;
+
+            JUCE_DECLARE_NON_COPYABLE(ScopedTransaction)
+        };
+
         //==============================================================================================================
         StatefulObject(const juce::Identifier& type = "UnnamedStatefulObject", StatefulObject* parentState = nullptr)
             : valueTree{ type }
@@ -31,6 +71,15 @@ namespace jump
             return getPropertyRecursively(name);
         }
 
+        /** Opens a transaction on this object that lasts until the returned object is destroyed.
+
+            @see ScopedTransaction
+        */
+        ScopedTransaction createTransaction()
+        {
+            return ScopedTransaction{ *this };
+        }
+
     protected:
         //==============================================================================================================
         juce::ValueTree& getState()
@@ -38,6 +87,20 @@ namespace jump
             return valueTree;
         }
 
+        /** Returns true if a transaction is open on this object or any of its parents. */
+        bool isInTransaction() const noexcept
+        {
+            return transactionDepth > 0 || (parent != nullptr && parent->isInTransaction());
+        }
+
+        /** Called once the outermost transaction covering this object has ended.
+
+            Derived classes should override this to do any work they deferred while isInTransaction() returned true.
+        */
+        virtual void transactionCommitted()
+        {
+        }
+
     private:
         //==============================================================================================================
         void valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& name) override
@@ -76,6 +139,18 @@ namespace jump
             jassert(child->valueTree.isValid());
         }
 
+        void commitTransactionRecursively()
+        {
+            // A child with a transaction of its own still open will be committed when that ends.
+            if (transactionDepth > 0)
+                return;
+
+            transactionCommitted();
+
+            for (auto& child : children)
+                child->commitTransactionRecursively();
+        }
+
         void callPropertyChangedRecursively(const juce::ValueTree& originTree, const juce::Identifier& name)
         {
             propertyChanged(name, originTree[name]);
@@ -101,5 +176,7 @@ namespace jump
 
         StatefulObject* parent{ nullptr };
         juce::Array<StatefulObject*> children;
+
+        int transactionDepth{ 0 };
     };
 } // namespace jump
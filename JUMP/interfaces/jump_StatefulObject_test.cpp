@@ -0,0 +1,109 @@
+#if JUCE_UNIT_TESTS
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    class StatefulObjectTests : public juce::UnitTest
+    {
+    public:
+        //==============================================================================================================
+        StatefulObjectTests()
+            : juce::UnitTest{ "StatefulObject", "Interfaces" }
+        {
+        }
+
+        //==============================================================================================================
+        void runTest() override
+        {
+            static const juce::Identifier propertyId{ "property" };
+
+            beginTest("Transactions are committed once, when the outermost one ends");
+            {
+                TransactionRecorder object;
+
+                {
+                    const auto transaction = object.createTransaction();
+                    object.setProperty(propertyId, 1);
+
+                    {
+                        const auto nestedTransaction = object.createTransaction();
+                        object.setProperty(propertyId, 2);
+                    }
+
+                    expectEquals(object.numCommits, 0);
+                }
+
+                expectEquals(object.numPropertyChanges, 2);
+                expect(object.wasInTransaction);
+                expectEquals(object.numCommits, 1);
+                expect(!object.isInTransaction());
+            }
+
+            beginTest("Children are committed along with their parent");
+            {
+                TransactionRecorder parent;
+                TransactionRecorder child{ "Child", &parent };
+
+                {
+                    const auto transaction = parent.createTransaction();
+                    parent.setProperty(propertyId, 1);
+
+                    expect(child.isInTransaction());
+                }
+
+                expectEquals(child.numPropertyChanges, 1);
+                expect(child.wasInTransaction);
+                expectEquals(parent.numCommits, 1);
+                expectEquals(child.numCommits, 1);
+            }
+
+            beginTest("A child's own transaction delays its commit");
+            {
+                TransactionRecorder parent;
+                TransactionRecorder child{ "Child", &parent };
+
+                {
+                    const auto childTransaction = child.createTransaction();
+
+                    {
+                        const auto parentTransaction = parent.createTransaction();
+                        parent.setProperty(propertyId, 1);
+                    }
+
+                    expectEquals(parent.numCommits, 1);
+                    expectEquals(child.numCommits, 0);
+                }
+
+                expectEquals(child.numCommits, 1);
+            }
+        }
+
+    private:
+        //==============================================================================================================
+        struct TransactionRecorder : public StatefulObject
+        {
+            using StatefulObject::StatefulObject;
+            using StatefulObject::isInTransaction;
+
+            void propertyChanged(const juce::Identifier&, const juce::var&) override
+            {
+                numPropertyChanges++;
+                wasInTransaction = isInTransaction();
+            }
+
+            void transactionCommitted() override
+            {
+                numCommits++;
+            }
+
+            int numPropertyChanges{ 0 };
+            int numCommits{ 0 };
+            bool wasInTransaction{ false };
+        };
+    };
+
+    static StatefulObjectTests statefulObjectTests;
+} // namespace jump
+
+#endif
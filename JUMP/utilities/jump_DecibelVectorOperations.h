@@ -0,0 +1,152 @@
+#pragma once
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    /** Batch operations for converting whole arrays of levels between gains, Decibels and normalised values.
+
+        These do the same job as calling juce::Decibels::gainToDecibels() or juce::NormalisableRange::convertTo0to1()
+        on every element but are written as simple branch-free loops over contiguous arrays so the compiler can
+        vectorise them, which matters when converting hundreds of points for each frame of several visualisers.
+    */
+    struct DecibelVectorOperations
+    {
+        //==============================================================================================================
+        /** Returns an approximation of log2(value).
+
+            The value is split into its exponent and a mantissa in the range [sqrt(0.5), sqrt(2)), for which the first
+            three terms of the series for atanh are used. The absolute error is less than 4e-6, which equates to an
+            error of less than 0.00003dB when used to calculate Decibels - far smaller than anything that could be
+            drawn.
+
+            The value must be a positive, normal float.
+        */
+        static float fastLog2(float value) noexcept
+        {
+            jassert(value >= std::numeric_limits<float>::min());
+
+            static constexpr std::uint32_t sqrtHalfBits = 0x3f3504f3;
+
+            std::uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+
+            const auto exponent = static_cast<std::int32_t>(bits - sqrtHalfBits) >> 23;
+            bits -= static_cast<std::uint32_t>(exponent) << 23;
+
+            float mantissa;
+            std::memcpy(&mantissa, &bits, sizeof(mantissa));
+
+            const auto s = (mantissa - 1.f) / (mantissa + 1.f);
+            const auto s2 = s * s;
+
+            return static_cast<float>(exponent) + s * (2.885390082f + s2 * (0.961796694f + s2 * 0.577078017f));
+        }
+
+        //==============================================================================================================
+        /** Converts an array of gains to Decibels.
+
+            @param destination      The array to write the Decibel values to. This may be the same as source.
+            @param source           The gains to convert. These should be positive or zero.
+            @param numValues        The number of values to convert.
+            @param gainMultiplier   A factor that each gain is multiplied by before being converted, e.g. to normalise
+                                    the magnitudes produced by an FFT.
+            @param minusInfinityDB  The level below which values are treated as -inf Decibels. Every result is at least
+                                    this value.
+            @param useFastLog       If true, fastLog2() is used in place of std::log10() - see fastLog2() for the error
+                                    bound.
+        */
+        static void gainsToDecibels(float* destination, const float* source, int numValues, float gainMultiplier,
+                                    float minusInfinityDB = static_cast<float>(defaultMinusInfDB),
+                                    bool useFastLog = true) noexcept
+        {
+            // Clamping rather than branching keeps the loops vectorisable, and keeps the logs away from zero.
+            const auto minimumGain = juce::Decibels::decibelsToGain(minusInfinityDB - 1.f, minusInfinityDB - 2.f);
+
+            if (useFastLog)
+            {
+                // 20 * log10(x) == 20 * log10(2) * log2(x)
+                static constexpr auto decibelsPerOctave = 6.020599913f;
+
+                for (auto i = 0; i < numValues; i++)
+                {
+                    const auto gain = juce::jmax(source[i] * gainMultiplier, minimumGain);
+                    destination[i] = juce::jmax(decibelsPerOctave * fastLog2(gain), minusInfinityDB);
+                }
+            }
+            else
+            {
+                for (auto i = 0; i < numValues; i++)
+                {
+                    const auto gain = juce::jmax(source[i] * gainMultiplier, minimumGain);
+                    destination[i] = juce::jmax(20.f * std::log10(gain), minusInfinityDB);
+                }
+            }
+        }
+
+        /** Converts an array of Decibel values to proportions of the given range.
+
+            Values outside the range are limited to 0 or 1, in the same way as calling range.snapToLegalValue() before
+            range.convertTo0to1(). Ranges with an interval, a symmetric skew or custom conversion functions are
+            converted one value at a time by the range itself, so only plain (optionally skewed) ranges are vectorised.
+
+            @param destination  The array to write the normalised values to. This may be the same as source.
+            @param source       The Decibel values to convert.
+            @param numValues    The number of values to convert.
+            @param range        The range to normalise the values to.
+        */
+        static void decibelsToNormalised(float* destination, const float* source, int numValues,
+                                         const juce::NormalisableRange<float>& range) noexcept
+        {
+            if (!hasDefaultConversion(range))
+            {
+                for (auto i = 0; i < numValues; i++)
+                    destination[i] = range.convertTo0to1(range.snapToLegalValue(source[i]));
+
+                return;
+            }
+
+            const auto offset = -range.start;
+            const auto scale = 1.f / (range.end - range.start);
+
+            for (auto i = 0; i < numValues; i++)
+                destination[i] = juce::jlimit(0.f, 1.f, (source[i] + offset) * scale);
+
+            if (!juce::approximatelyEqual(range.skew, 1.f))
+            {
+                for (auto i = 0; i < numValues; i++)
+                    destination[i] = std::pow(destination[i], range.skew);
+            }
+        }
+
+    private:
+        //==============================================================================================================
+        /** Returns true if the range normalises values using nothing but its start, end and skew, in which case
+            decibelsToNormalised() can do the same without calling back into the range for every value.
+
+            Ranges with a symmetric skew, an interval or custom conversion functions all need the range's own
+            conversion. The custom functions aren't accessible, so they're detected by checking how the range converts
+            a handful of values across it.
+        */
+        static bool hasDefaultConversion(const juce::NormalisableRange<float>& range) noexcept
+        {
+            if (range.symmetricSkew || range.interval > 0.f)
+                return false;
+
+            static constexpr auto tolerance = 1.0e-5f;
+
+            for (const auto proportion : { 0.f, 0.25f, 0.5f, 0.75f, 1.f })
+            {
+                const auto value = range.start + proportion * (range.end - range.start);
+
+                if (std::abs(range.snapToLegalValue(value) - value) > tolerance * std::abs(range.end - range.start)
+                    || std::abs(range.convertTo0to1(value) - std::pow(proportion, range.skew)) > tolerance)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    };
+} // namespace jump
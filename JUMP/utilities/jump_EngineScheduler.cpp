@@ -0,0 +1,232 @@
+#include "jump_EngineScheduler.h"
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    EngineScheduler::~EngineScheduler()
+    {
+        // Clients should have removed themselves before the last reference to the scheduler went away.
+        jassert(getNumClients() == 0);
+
+        stopTimer();
+    }
+
+    //==================================================================================================================
+    void EngineScheduler::addClient(Client& client, int targetFPS, Priority priority)
+    {
+        if (targetFPS <= 0)
+        {
+            removeClient(client);
+            return;
+        }
+
+        if (auto* entry = findEntry(client))
+        {
+            entry->targetFPS = targetFPS;
+            entry->priority = priority;
+        }
+        else
+        {
+            entries.push_back({ &client, targetFPS, priority });
+        }
+
+        updateTimer();
+    }
+
+    void EngineScheduler::removeClient(Client& client)
+    {
+        auto* entry = findEntry(client);
+
+        if (entry == nullptr)
+            return;
+
+        // Erasing the entry while the clients are being updated would shift the ones yet to be updated, so it's only
+        // marked for removal until the tick is done.
+        entry->client = nullptr;
+
+        if (!isUpdatingClients)
+            removeStaleEntries();
+
+        updateTimer();
+    }
+
+    void EngineScheduler::setPriority(Client& client, Priority newPriority)
+    {
+        if (auto* entry = findEntry(client))
+            entry->priority = newPriority;
+    }
+
+    int EngineScheduler::getUpdateInterval(const Client& client) const noexcept
+    {
+        const auto iter = std::find_if(entries.begin(), entries.end(), [&client](const Entry& entry) {
+            return entry.client == &client;
+        });
+
+        if (iter == entries.end())
+            return 0;
+
+        return juce::roundToInt(getInterval(*iter));
+    }
+
+    int EngineScheduler::getNumClients() const noexcept
+    {
+        return static_cast<int>(std::count_if(entries.begin(), entries.end(), [](const Entry& entry) {
+            return entry.client != nullptr;
+        }));
+    }
+
+    //==================================================================================================================
+    void EngineScheduler::setFrameBudget(double newFrameBudgetMs)
+    {
+        jassert(newFrameBudgetMs > 0.0);
+
+        frameBudgetMs = newFrameBudgetMs;
+    }
+
+    //==================================================================================================================
+    void EngineScheduler::timerCallback()
+    {
+        const auto tickStartTime = juce::Time::getMillisecondCounterHiRes();
+        const auto now = juce::Time::getMillisecondCounter();
+
+        // The timer's ticks jitter, so a client counts as due if it would be due before the tick is half-way to the
+        // next one.
+        const auto tolerance = getTimerInterval() * 0.5;
+
+        isUpdatingClients = true;
+
+        // Indexed rather than iterated, since a client may add another client (and so reallocate the entries) from its
+        // update.
+        for (std::size_t i = 0; i < entries.size(); i++)
+        {
+            auto& entry = entries[i];
+
+            if (entry.client == nullptr || tickStartTime + tolerance < entry.nextUpdateTime)
+                continue;
+
+            const auto interval = getInterval(entry);
+            entry.nextUpdateTime += interval;
+
+            // Rather than trying to catch up on updates missed while the message thread was busy, start again from
+            // this tick.
+            if (entry.nextUpdateTime < tickStartTime)
+                entry.nextUpdateTime = tickStartTime + interval;
+
+            entry.client->scheduledUpdate(now);
+        }
+
+        isUpdatingClients = false;
+        removeStaleEntries();
+
+        adaptRates(juce::Time::getMillisecondCounterHiRes() - tickStartTime);
+    }
+
+    //==================================================================================================================
+    EngineScheduler::Entry* EngineScheduler::findEntry(const Client& client) noexcept
+    {
+        const auto iter = std::find_if(entries.begin(), entries.end(), [&client](const Entry& entry) {
+            return entry.client == &client;
+        });
+
+        return iter == entries.end() ? nullptr : &*iter;
+    }
+
+    void EngineScheduler::updateTimer()
+    {
+        auto fastestFPS = 0;
+
+        for (const auto& entry : entries)
+        {
+            if (entry.client != nullptr)
+                fastestFPS = juce::jmax(fastestFPS, entry.targetFPS);
+        }
+
+        if (fastestFPS == 0)
+        {
+            stopTimer();
+            return;
+        }
+
+        // Restarting the timer resets its phase, so it's only done when the rate actually changes.
+        if (getTimerInterval() != 1000 / fastestFPS)
+            startTimerHz(fastestFPS);
+    }
+
+    void EngineScheduler::removeStaleEntries()
+    {
+        entries.erase(std::remove_if(entries.begin(),
+                                     entries.end(),
+                                     [](const Entry& entry) {
+                                         return entry.client == nullptr;
+                                     }),
+                      entries.end());
+    }
+
+    void EngineScheduler::adaptRates(double tickDurationMs)
+    {
+        if (tickDurationMs > frameBudgetMs)
+        {
+            numTicksUnderBudget = 0;
+
+            if (auto* entry = findEntryToSlowDown())
+                entry->rateDivisor *= 2;
+
+            return;
+        }
+
+        // Only speed clients back up after a sustained run of cheap ticks so the rates don't flip back and forth.
+        if (tickDurationMs > frameBudgetMs * 0.5 || ++numTicksUnderBudget < numTicksBeforeSpeedingUp)
+            return;
+
+        numTicksUnderBudget = 0;
+
+        if (auto* entry = findEntryToSpeedUp())
+            entry->rateDivisor /= 2;
+    }
+
+    EngineScheduler::Entry* EngineScheduler::findEntryToSlowDown() noexcept
+    {
+        Entry* leastImportant = nullptr;
+
+        for (auto& entry : entries)
+        {
+            if (entry.rateDivisor >= maxRateDivisor)
+                continue;
+
+            if (leastImportant == nullptr || getImportance(entry) < getImportance(*leastImportant))
+                leastImportant = &entry;
+        }
+
+        return leastImportant;
+    }
+
+    EngineScheduler::Entry* EngineScheduler::findEntryToSpeedUp() noexcept
+    {
+        Entry* mostImportant = nullptr;
+
+        for (auto& entry : entries)
+        {
+            if (entry.rateDivisor <= 1)
+                continue;
+
+            if (mostImportant == nullptr || getImportance(entry) > getImportance(*mostImportant))
+                mostImportant = &entry;
+        }
+
+        return mostImportant;
+    }
+
+    double EngineScheduler::getInterval(const Entry& entry) noexcept
+    {
+        return 1000.0 * entry.rateDivisor / entry.targetFPS;
+    }
+
+    int EngineScheduler::getImportance(const Entry& entry)
+    {
+        // Being visible outweighs any priority.
+        const auto visibility = entry.client->hasVisibleRenderers() ? 3 : 0;
+
+        return visibility + static_cast<int>(entry.priority);
+    }
+} // namespace jump
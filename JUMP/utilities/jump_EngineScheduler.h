@@ -0,0 +1,135 @@
+#pragma once
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    /** Updates every engine from a single timer on the message thread.
+
+        Rather than each engine running its own juce::Timer, engines register themselves as clients of this scheduler
+        with a target rate and a priority. The scheduler runs one timer at the fastest rate any client needs and, on
+        each tick, updates every client that's due - so all the engines updated on a given tick see the same time and
+        stay in phase with one another.
+
+        The time taken by each tick is measured against a per-frame budget. When a tick runs over budget, the rate of
+        the least important client is halved, where clients with no visible renderers are the least important, followed
+        by those with the lowest priority. Once ticks are comfortably within budget again, the rates are restored, most
+        important client first.
+
+        Access it through a juce::SharedResourcePointer<EngineScheduler> so the timer only exists while there are
+        engines using it. All of its methods must be called from the message thread.
+    */
+    class EngineScheduler : private juce::Timer
+    {
+    public:
+        //==============================================================================================================
+        /** The relative importance of a client, used to decide which clients are slowed down first when the scheduler
+            runs over its budget.
+        */
+        enum class Priority
+        {
+            low,
+            normal,
+            high
+        };
+
+        //==============================================================================================================
+        /** Base class for objects that can be updated by the scheduler. */
+        struct Client
+        {
+            //==========================================================================================================
+            virtual ~Client() = default;
+
+            //==========================================================================================================
+            /** Called by the scheduler each time the client is due an update.
+
+                @param now  The time of the scheduler's tick, as given by juce::Time::getMillisecondCounter(). Every
+                            client updated on the same tick is given the same time.
+            */
+            virtual void scheduledUpdate(juce::uint32 now) = 0;
+
+            /** Returns true if anything the client updates is currently visible to the user.
+
+                Clients with nothing visible are slowed down before any others when the scheduler runs over budget.
+            */
+            virtual bool hasVisibleRenderers() const = 0;
+        };
+
+        //==============================================================================================================
+        EngineScheduler() = default;
+        ~EngineScheduler() override;
+
+        //==============================================================================================================
+        /** Registers a client to be updated at the given rate, or changes the rate and priority of a client that's
+            already registered.
+
+            @param client       The client to update.
+            @param targetFPS    The rate at which the client should be updated. If this is 0 or less, the client is
+                                removed instead.
+            @param priority     The priority of the client.
+        */
+        void addClient(Client& client, int targetFPS, Priority priority = Priority::normal);
+
+        /** Stops a client from being updated. This is safe to call from within a client's scheduledUpdate(). */
+        void removeClient(Client& client);
+
+        /** Changes the priority of a client that's already registered. */
+        void setPriority(Client& client, Priority newPriority);
+
+        /** Returns the interval, in milliseconds, at which the given client is currently being updated, or 0 if it
+            isn't registered.
+
+            This is the interval of the client's target rate, lengthened by however much the client has been slowed
+            down to keep the scheduler within its budget.
+        */
+        int getUpdateInterval(const Client& client) const noexcept;
+
+        /** Returns the number of clients currently registered. */
+        int getNumClients() const noexcept;
+
+        //==============================================================================================================
+        /** Changes the time, in milliseconds, that updating all the clients due on a single tick should take.
+
+            The default is 4ms - a quarter of a frame at 60Hz.
+        */
+        void setFrameBudget(double newFrameBudgetMs);
+
+    private:
+        //==============================================================================================================
+        struct Entry
+        {
+            Client* client{ nullptr };
+            int targetFPS{ 0 };
+            Priority priority{ Priority::normal };
+            int rateDivisor{ 1 };
+            double nextUpdateTime{ 0.0 };
+        };
+
+        //==============================================================================================================
+        void timerCallback() override;
+
+        //==============================================================================================================
+        Entry* findEntry(const Client& client) noexcept;
+        void updateTimer();
+        void removeStaleEntries();
+        void adaptRates(double tickDurationMs);
+        Entry* findEntryToSlowDown() noexcept;
+        Entry* findEntryToSpeedUp() noexcept;
+
+        static double getInterval(const Entry& entry) noexcept;
+        static int getImportance(const Entry& entry);
+
+        //==============================================================================================================
+        static constexpr int maxRateDivisor = 8;
+        static constexpr int numTicksBeforeSpeedingUp = 60;
+
+        //==============================================================================================================
+        std::vector<Entry> entries;
+        double frameBudgetMs{ 4.0 };
+        int numTicksUnderBudget{ 0 };
+        bool isUpdatingClients{ false };
+
+        //==============================================================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EngineScheduler)
+    };
+} // namespace jump
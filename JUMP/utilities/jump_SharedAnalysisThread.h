@@ -0,0 +1,33 @@
+#pragma once
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    /** A background thread shared by every engine that does its analysis off the message thread.
+
+        Rather than each engine starting its own thread, engines register themselves as juce::TimeSliceClients with
+        this thread, which takes it in turns to call each of them. Access it through a
+        juce::SharedResourcePointer<SharedAnalysisThread> so the thread is started when the first engine needs it and
+        stopped once the last one is done with it.
+    */
+    class SharedAnalysisThread : public juce::TimeSliceThread
+    {
+    public:
+        //==============================================================================================================
+        SharedAnalysisThread()
+            : juce::TimeSliceThread{ "JUMP Analysis Thread" }
+        {
+            startThread();
+        }
+
+        ~SharedAnalysisThread() override
+        {
+            stopThread(1000);
+        }
+
+    private:
+        //==============================================================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharedAnalysisThread)
+    };
+} // namespace jump
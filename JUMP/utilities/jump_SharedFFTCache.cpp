@@ -0,0 +1,45 @@
+#include "jump_SharedFFTCache.h"
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    std::shared_ptr<const juce::dsp::FFT> SharedFFTCache::getFFT(int order)
+    {
+        // The lock is held while creating the FFT so engines asking for the same order at the same time don't each
+        // create their own.
+        const juce::ScopedLock scopedLock{ lock };
+
+        if (auto existing = ffts[order].lock())
+            return existing;
+
+        removeExpiredEntries(ffts);
+
+        auto fft = std::make_shared<const juce::dsp::FFT>(order);
+        ffts[order] = fft;
+
+        return fft;
+    }
+
+    std::shared_ptr<const std::vector<float>> SharedFFTCache::getWindowingTable(int length, WindowingMethod method,
+                                                                                bool normalise)
+    {
+        jassert(length > 0);
+
+        const juce::ScopedLock scopedLock{ lock };
+        const auto key = WindowingTableKey{ length, method, normalise };
+
+        if (auto existing = windowingTables[key].lock())
+            return existing;
+
+        removeExpiredEntries(windowingTables);
+
+        auto table = std::vector<float>(static_cast<std::size_t>(length));
+        juce::dsp::WindowingFunction<float>::fillWindowingTables(table.data(), table.size(), method, normalise);
+
+        auto sharedTable = std::make_shared<const std::vector<float>>(std::move(table));
+        windowingTables[key] = sharedTable;
+
+        return sharedTable;
+    }
+} // namespace jump
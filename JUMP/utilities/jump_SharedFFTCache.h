@@ -0,0 +1,62 @@
+#pragma once
+
+//======================================================================================================================
+namespace jump
+{
+    //==================================================================================================================
+    /** Hands out FFTs and windowing tables shared by every engine that uses the same settings.
+
+        Creating an FFT (which may involve planning it with a platform-specific library) and filling a windowing table
+        are relatively expensive, yet many engines tend to use the same FFT order and windowing method. Rather than
+        each engine creating its own, engines ask this cache, which returns the existing instance if any other engine
+        is still using one with the same settings. Both the FFTs and the tables are immutable once created, so they
+        can be used by any number of engines on any number of threads at once, and engines that share them also share
+        the same memory in the CPU's caches.
+
+        The cache only holds weak references, so an FFT or table is freed as soon as the last engine using it lets it
+        go. Access it through a juce::SharedResourcePointer<SharedFFTCache>. It can be used from any thread.
+    */
+    class SharedFFTCache
+    {
+    public:
+        //==============================================================================================================
+        using WindowingMethod = juce::dsp::WindowingFunction<float>::WindowingMethod;
+
+        //==============================================================================================================
+        SharedFFTCache() = default;
+
+        //==============================================================================================================
+        /** Returns an FFT of the given order, creating it if no other engine is using one. */
+        std::shared_ptr<const juce::dsp::FFT> getFFT(int order);
+
+        /** Returns a windowing table with the given settings, creating it if no other engine is using one.
+
+            @param length       The number of samples in the table.
+            @param method       The windowing method to fill the table with.
+            @param normalise    Whether the table should be normalised, as in
+                                juce::dsp::WindowingFunction::fillWindowingTables().
+        */
+        std::shared_ptr<const std::vector<float>> getWindowingTable(int length, WindowingMethod method,
+                                                                    bool normalise = true);
+
+    private:
+        //==============================================================================================================
+        using WindowingTableKey = std::tuple<int, WindowingMethod, bool>;
+
+        //==============================================================================================================
+        template <typename Key, typename Value>
+        static void removeExpiredEntries(std::map<Key, std::weak_ptr<Value>>& entries)
+        {
+            for (auto iter = entries.begin(); iter != entries.end();)
+                iter = iter->second.expired() ? entries.erase(iter) : std::next(iter);
+        }
+
+        //==============================================================================================================
+        juce::CriticalSection lock;
+        std::map<int, std::weak_ptr<const juce::dsp::FFT>> ffts;
+        std::map<WindowingTableKey, std::weak_ptr<const std::vector<float>>> windowingTables;
+
+        //==============================================================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharedFFTCache)
+    };
+} // namespace jump